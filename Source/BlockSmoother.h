@@ -0,0 +1,90 @@
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Parameter smoother that produces a whole block of values per call.
+
+    One smoother state is kept per channel, so channels that each consume a ramp
+    advance at the correct rate. isSettled() is a cheap check that lets callers
+    skip the ramp and use getTargetValue() as a constant.
+    Use ValueSmoothingTypes::Multiplicative for linear gains, where a
+    multiplicative ramp is a straight line in dB.
+*/
+template <typename SampleType, typename SmoothingType = juce::ValueSmoothingTypes::Linear>
+class BlockSmoother
+{
+public:
+    explicit BlockSmoother(SampleType initialValue = 0) : target(initialValue) {}
+
+    // Allocate numChannels states and ramps of maximumBlockSize, then snap to the target
+    void prepare(double sampleRate, double rampLengthSeconds, int numChannels, int maximumBlockSize)
+    {
+        numChannels = juce::jmax(1, numChannels);
+        maximumBlockSize = juce::jmax(1, maximumBlockSize);
+
+        smoothers.resize((size_t)numChannels);
+        for (auto& smoother : smoothers)
+        {
+            smoother.reset(sampleRate, rampLengthSeconds);
+            smoother.setCurrentAndTargetValue(target);
+        }
+
+        ramps.setSize(numChannels, maximumBlockSize);
+        ramps.clear();
+    }
+
+    // Ramp every channel towards newTarget
+    void setTargetValue(SampleType newTarget) noexcept
+    {
+        if (newTarget == target)
+            return;
+
+        target = newTarget;
+        for (auto& smoother : smoothers)
+            smoother.setTargetValue(target);
+    }
+
+    SampleType getTargetValue() const noexcept { return target; }
+    int getNumChannels() const noexcept { return (int)smoothers.size(); }
+    int getMaximumBlockSize() const noexcept { return ramps.getNumSamples(); }
+
+    // True once this channel has reached the target
+    bool isSettled(int channel = 0) const noexcept
+    {
+        return !smoothers[(size_t)channel].isSmoothing();
+    }
+
+    // Fill and return the next numSamples values for this channel (numSamples <= getMaximumBlockSize())
+    const SampleType* getNextBlock(int channel, int numSamples) noexcept
+    {
+        jassert(numSamples <= ramps.getNumSamples());
+
+        auto& smoother = smoothers[(size_t)channel];
+        auto* ramp = ramps.getWritePointer(channel);
+
+        if (!smoother.isSmoothing())
+        {
+            juce::FloatVectorOperations::fill(ramp, target, numSamples);
+            return ramp;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            ramp[i] = smoother.getNextValue();
+
+        return ramp;
+    }
+
+    // Advance this channel without producing values
+    void skip(int channel, int numSamples) noexcept
+    {
+        smoothers[(size_t)channel].skip(numSamples);
+    }
+
+private:
+    std::vector<juce::SmoothedValue<SampleType, SmoothingType>> smoothers;
+    juce::AudioBuffer<SampleType> ramps; // One ramp per channel
+    SampleType target;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BlockSmoother)
+};
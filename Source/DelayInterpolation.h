@@ -0,0 +1,61 @@
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+// How the delay line is read for a run of samples. Chosen once per tile and passed
+// to the kernels as a template argument, so they have no per-sample branches on it.
+enum class DelayMode
+{
+    bypass,     // Delay time <= 0: input goes straight into the delay line
+    integer,    // Settled whole-sample delay: a single tap
+    cubicFixed, // Settled fractional delay: fixed 4-tap FIR
+    cubic       // Ramping delay: read position and weights recomputed every sample
+};
+
+//==============================================================================
+// Windowed cubic spline interpolation between y1 and y2
+struct CubicInterpolator
+{
+    template <typename T>
+    static T interpolate(T y0, T y1, T y2, T y3, T fractionalPosition)
+    {
+        // Audio optimised formula based off of: https://github.com/kmatheussen/radium/blob/master/audio/SampleInterpolator.cpp
+        // Written by Kjetil Matheussen
+
+        // Calculates a windowed cubic spline interpolation, using custom coefficients instead of Hermite basis functions.
+
+        // Half-weight the outer points to reduce pull of distant samples
+        T half_y0 = (T)0.5 * y0;
+        T half_y3 = (T)0.5 * y3;
+
+        // Get tangeant at y1
+        T slope_y1_to_y2 = ((T)0.5 * y2) - half_y0;
+
+        // Calculate the curvature components
+        T curvature_term1 = (y0 + ((T)2.0 * y2)) - (half_y3 + ((T)2.5 * y1));       // Dampens y1
+        T curvature_term2 = (half_y3 + ((T)1.5 * y1)) - (((T)1.5 * y2) + half_y0); // Flatten curve at y2 to prevent overshoot
+
+        // Combine all components using Horner's method for efficiency
+        return y1 + fractionalPosition * (
+            slope_y1_to_y2 + fractionalPosition * (
+                curvature_term1 + fractionalPosition * (
+                    curvature_term2
+                    )
+                )
+            );
+    }
+
+    // Weights of y0..y3 in interpolate() for a fixed fractional position
+    template <typename T>
+    static void getCoefficients(T fractionalPosition, T (&coefficients)[4])
+    {
+        const T f = fractionalPosition;
+        const T f2 = f * f;
+        const T f3 = f2 * f;
+
+        coefficients[0] = ((T)-0.5 * f) + f2 - ((T)0.5 * f3);
+        coefficients[1] = (T)1 - ((T)2.5 * f2) + ((T)1.5 * f3);
+        coefficients[2] = ((T)0.5 * f) + ((T)2 * f2) - ((T)1.5 * f3);
+        coefficients[3] = ((T)-0.5 * f2) + ((T)0.5 * f3);
+    }
+};
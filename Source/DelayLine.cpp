@@ -0,0 +1,80 @@
+#include "DelayLine.h"
+
+template <typename SampleType>
+void DelayLine<SampleType>::prepare(int numChannels, int minimumCapacity)
+{
+    capacity = juce::nextPowerOfTwo(juce::jmax(2, minimumCapacity));
+    mask = capacity - 1;
+    writePosition = 0;
+
+    buffer.setSize(numChannels, capacity);
+    buffer.clear();
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::clear()
+{
+    buffer.clear();
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::clear(int channel)
+{
+    if (channel < buffer.getNumChannels())
+        buffer.clear(channel, 0, capacity);
+}
+
+template <typename SampleType>
+typename DelayLine<SampleType>::Span DelayLine<SampleType>::makeSpan(int channel, int startPosition, int numSamples) const noexcept
+{
+    jassert(numSamples <= capacity);
+
+    // const_cast keeps one helper for both read and write spans
+    auto* data = const_cast<SampleType*>(buffer.getReadPointer(channel));
+    const int start = startPosition & mask;
+    const int numToEnd = juce::jmin(numSamples, capacity - start);
+
+    Span span;
+    span.data1 = data + start;
+    span.size1 = numToEnd;
+    span.data2 = data;
+    span.size2 = numSamples - numToEnd; // Wrapped remainder from the start of the ring
+    return span;
+}
+
+template <typename SampleType>
+typename DelayLine<SampleType>::Span DelayLine<SampleType>::getWriteSpan(int channel, int numSamples, int offset) noexcept
+{
+    return makeSpan(channel, writePosition + offset, numSamples);
+}
+
+template <typename SampleType>
+typename DelayLine<SampleType>::Span DelayLine<SampleType>::getReadSpan(int channel, int delayInSamples, int numSamples) noexcept
+{
+    return makeSpan(channel, writePosition - delayInSamples, numSamples);
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::write(int channel, const SampleType* source, int numSamples, int offset) noexcept
+{
+    auto span = getWriteSpan(channel, numSamples, offset);
+    juce::FloatVectorOperations::copy(span.data1, source, span.size1);
+    juce::FloatVectorOperations::copy(span.data2, source + span.size1, span.size2);
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::read(int channel, int delayInSamples, SampleType* destination, int numSamples) const noexcept
+{
+    auto span = makeSpan(channel, writePosition - delayInSamples, numSamples);
+    juce::FloatVectorOperations::copy(destination, span.data1, span.size1);
+    juce::FloatVectorOperations::copy(destination + span.size1, span.data2, span.size2);
+}
+
+template <typename SampleType>
+void DelayLine<SampleType>::advance(int numSamples) noexcept
+{
+    writePosition = (writePosition + numSamples) & mask;
+}
+
+template class DelayLine<float>;
+template class DelayLine<double>;
@@ -0,0 +1,66 @@
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Multichannel ring buffer for the delay effect.
+
+    Capacity is rounded up to a power of two so positions wrap with a mask rather
+    than %. Block access is given as a Span: a region of the ring split at the wrap
+    point into at most two contiguous parts, so hot loops run over plain memory.
+*/
+template <typename SampleType>
+class DelayLine
+{
+public:
+    // Ring region split at the wrap point. size2 is 0 when the region doesn't wrap
+    struct Span
+    {
+        SampleType* data1{ nullptr };
+        int size1{ 0 };
+        SampleType* data2{ nullptr };
+        int size2{ 0 };
+    };
+
+    DelayLine() = default;
+
+    // Allocate and clear. Capacity becomes the next power of two >= minimumCapacity
+    void prepare(int numChannels, int minimumCapacity);
+
+    void clear();
+    void clear(int channel);
+
+    int getNumChannels() const noexcept { return buffer.getNumChannels(); }
+    int getCapacity() const noexcept    { return capacity; }
+    int getMask() const noexcept        { return mask; }
+    int getWritePosition() const noexcept { return writePosition; }
+
+    // Raw ring memory, index with (position & getMask())
+    const SampleType* getReadPointer(int channel) const noexcept { return buffer.getReadPointer(channel); }
+    SampleType* getWritePointer(int channel) noexcept           { return buffer.getWritePointer(channel); }
+
+    // Region the next numSamples will be written to, starting offset samples past the write position
+    Span getWriteSpan(int channel, int numSamples, int offset = 0) noexcept;
+
+    // Region lying delayInSamples behind the write position
+    Span getReadSpan(int channel, int delayInSamples, int numSamples) noexcept;
+
+    // Copy a block into the ring at the write position + offset (doesn't advance)
+    void write(int channel, const SampleType* source, int numSamples, int offset = 0) noexcept;
+
+    // Copy a block from delayInSamples behind the write position
+    void read(int channel, int delayInSamples, SampleType* destination, int numSamples) const noexcept;
+
+    // Move the write position on by numSamples. Call once per block, after all channels
+    void advance(int numSamples) noexcept;
+
+private:
+    Span makeSpan(int channel, int startPosition, int numSamples) const noexcept;
+
+    juce::AudioBuffer<SampleType> buffer;
+    int capacity{ 0 };
+    int mask{ 0 };
+    int writePosition{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DelayLine)
+};
@@ -0,0 +1,431 @@
+#include "DspKernels.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+
+ // MSVC allows any intrinsic without flags, GCC/Clang need the function marked for the instruction set
+ #if JUCE_MSVC
+  #define DSP_KERNEL_TARGET(isa)
+ #else
+  #define DSP_KERNEL_TARGET(isa) __attribute__((target(isa)))
+ #endif
+#endif
+
+// AVX-512 implies FMA, and GCC fuses a * b + c by default, even between separate mul/add intrinsics.
+// Every level must round the same way, so this file builds with the "noFpContract" compiler flag scheme
+// (-ffp-contract=off, /fp:precise) set in the .jucer. Clang also honours the standard pragma
+#if JUCE_CLANG
+ #pragma STDC FP_CONTRACT OFF
+#endif
+
+namespace
+{
+    // === GENERIC ===
+
+    void multiplyGeneric(float* data, const float* gains, int numSamples)
+    {
+        juce::FloatVectorOperations::multiply(data, gains, numSamples);
+    }
+
+    void cubicFirGeneric(float* dest, const float* taps, const float* coefficients, int numSamples)
+    {
+        juce::FloatVectorOperations::multiply(dest, taps, coefficients[0], numSamples);
+        juce::FloatVectorOperations::addWithMultiply(dest, taps + 1, coefficients[1], numSamples);
+        juce::FloatVectorOperations::addWithMultiply(dest, taps + 2, coefficients[2], numSamples);
+        juce::FloatVectorOperations::addWithMultiply(dest, taps + 3, coefficients[3], numSamples);
+    }
+
+    // log2(1 + r) ~= r * (c1 + r * (c2 + ...)) on r in [0, 1). Lawson-fitted, max error 1.5e-5 (4.3e-5 dB)
+    constexpr float log2C1 = 1.441965612839919f;
+    constexpr float log2C2 = -0.7096631439363735f;
+    constexpr float log2C3 = 0.4175976949771621f;
+    constexpr float log2C4 = -0.1962729093205367f;
+    constexpr float log2C5 = 0.04638707561835219f;
+
+    constexpr float decibelsPerOctave = 3.0102999566398120f;   // 10 * log10(2), power dB = this * log2(power)
+    constexpr float smallestPower = 1.17549435e-38f;            // Smallest normal float, keeps log2 finite
+
+    // Exponent straight from the float bits, polynomial for the mantissa. x must be a positive normal float
+    float fastLog2(float x) noexcept
+    {
+        juce::uint32 bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+
+        const float exponent = (float)((int)(bits >> 23) - 127);
+        bits = (bits & 0x007fffffu) | 0x3f800000u;
+
+        float mantissa;
+        std::memcpy(&mantissa, &bits, sizeof(mantissa));
+
+        const float r = mantissa - 1.0f;
+        return exponent + (r * (log2C1 + r * (log2C2 + r * (log2C3 + r * (log2C4 + r * log2C5)))));
+    }
+
+    // Shared scalar tails. Same operation order as the vector bodies, so every level gives identical results
+    void powerToDecibelsScalar(float* destDb, const float* complexBins, float scale, float minDb, int start, int numBins)
+    {
+        for (int bin = start; bin < numBins; ++bin)
+        {
+            const float real = complexBins[bin * 2];
+            const float imag = complexBins[bin * 2 + 1];
+            const float power = std::max(((real * real) + (imag * imag)) * scale, smallestPower);
+            destDb[bin] = std::max(decibelsPerOctave * fastLog2(power), minDb);
+        }
+    }
+
+    void decibelsFromPowerScalar(float* destDb, const float* power, float minDb, int start, int numValues)
+    {
+        for (int i = start; i < numValues; ++i)
+            destDb[i] = std::max(decibelsPerOctave * fastLog2(std::max(power[i], smallestPower)), minDb);
+    }
+
+    void cubicFirScalar(float* dest, const float* taps, const float* c, int start, int numSamples)
+    {
+        for (int i = start; i < numSamples; ++i)
+            dest[i] = (((taps[i] * c[0]) + (taps[i + 1] * c[1])) + (taps[i + 2] * c[2])) + (taps[i + 3] * c[3]);
+    }
+
+    void powerToDecibelsGeneric(float* destDb, const float* complexBins, float scale, float minDb, int numBins)
+    {
+        powerToDecibelsScalar(destDb, complexBins, scale, minDb, 0, numBins);
+    }
+
+    void decibelsFromPowerGeneric(float* destDb, const float* power, float minDb, int numValues)
+    {
+        decibelsFromPowerScalar(destDb, power, minDb, 0, numValues);
+    }
+
+   #if JUCE_INTEL
+    // === SSE2 ===
+
+    void multiplySse2(float* data, const float* gains, int numSamples)
+    {
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4)
+            _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), _mm_loadu_ps(gains + i)));
+
+        for (; i < numSamples; ++i)
+            data[i] *= gains[i];
+    }
+
+    void cubicFirSse2(float* dest, const float* taps, const float* coefficients, int numSamples)
+    {
+        const __m128 c0 = _mm_set1_ps(coefficients[0]), c1 = _mm_set1_ps(coefficients[1]);
+        const __m128 c2 = _mm_set1_ps(coefficients[2]), c3 = _mm_set1_ps(coefficients[3]);
+
+        int i = 0;
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            __m128 sum = _mm_mul_ps(_mm_loadu_ps(taps + i), c0);
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(taps + i + 1), c1));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(taps + i + 2), c2));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(taps + i + 3), c3));
+            _mm_storeu_ps(dest + i, sum);
+        }
+
+        cubicFirScalar(dest, taps, coefficients, i, numSamples);
+    }
+
+    __m128 fastLog2Sse2(__m128 x) noexcept
+    {
+        const __m128i bits = _mm_castps_si128(x);
+        const __m128 exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+        const __m128 mantissa = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+        const __m128 r = _mm_sub_ps(mantissa, _mm_set1_ps(1.0f));
+
+        __m128 poly = _mm_add_ps(_mm_set1_ps(log2C4), _mm_mul_ps(r, _mm_set1_ps(log2C5)));
+        poly = _mm_add_ps(_mm_set1_ps(log2C3), _mm_mul_ps(r, poly));
+        poly = _mm_add_ps(_mm_set1_ps(log2C2), _mm_mul_ps(r, poly));
+        poly = _mm_add_ps(_mm_set1_ps(log2C1), _mm_mul_ps(r, poly));
+        return _mm_add_ps(exponent, _mm_mul_ps(r, poly));
+    }
+
+    void powerToDecibelsSse2(float* destDb, const float* complexBins, float scale, float minDb, int numBins)
+    {
+        const __m128 scaleVec = _mm_set1_ps(scale);
+        const __m128 floorPower = _mm_set1_ps(smallestPower);
+        const __m128 floorDb = _mm_set1_ps(minDb);
+        const __m128 dbPerOctave = _mm_set1_ps(decibelsPerOctave);
+
+        int bin = 0;
+        for (; bin + 4 <= numBins; bin += 4)
+        {
+            const __m128 a = _mm_loadu_ps(complexBins + bin * 2);       // re0 im0 re1 im1
+            const __m128 b = _mm_loadu_ps(complexBins + bin * 2 + 4);   // re2 im2 re3 im3
+            const __m128 real = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 imag = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            const __m128 power = _mm_max_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(real, real), _mm_mul_ps(imag, imag)), scaleVec), floorPower);
+            _mm_storeu_ps(destDb + bin, _mm_max_ps(_mm_mul_ps(dbPerOctave, fastLog2Sse2(power)), floorDb));
+        }
+
+        powerToDecibelsScalar(destDb, complexBins, scale, minDb, bin, numBins);
+    }
+
+    void decibelsFromPowerSse2(float* destDb, const float* power, float minDb, int numValues)
+    {
+        const __m128 floorPower = _mm_set1_ps(smallestPower);
+        const __m128 floorDb = _mm_set1_ps(minDb);
+        const __m128 dbPerOctave = _mm_set1_ps(decibelsPerOctave);
+
+        int i = 0;
+        for (; i + 4 <= numValues; i += 4)
+        {
+            const __m128 value = _mm_max_ps(_mm_loadu_ps(power + i), floorPower);
+            _mm_storeu_ps(destDb + i, _mm_max_ps(_mm_mul_ps(dbPerOctave, fastLog2Sse2(value)), floorDb));
+        }
+
+        decibelsFromPowerScalar(destDb, power, minDb, i, numValues);
+    }
+
+    // === AVX2 ===
+
+    // The scalar tails are built as SSE code. GCC can tail-call them without a vzeroupper, and SSE code
+    // after dirty upper halves stalls, so the AVX2 kernels clear them first. vzeroupper leaves zmm16-31
+    // alone, so the AVX-512 kernels finish with masked tails instead of calling the scalar ones
+
+    DSP_KERNEL_TARGET("avx2")
+    void multiplyAvx2(float* data, const float* gains, int numSamples)
+    {
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8)
+            _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), _mm256_loadu_ps(gains + i)));
+
+        for (; i < numSamples; ++i)
+            data[i] *= gains[i];
+    }
+
+    DSP_KERNEL_TARGET("avx2")
+    void cubicFirAvx2(float* dest, const float* taps, const float* coefficients, int numSamples)
+    {
+        const __m256 c0 = _mm256_set1_ps(coefficients[0]), c1 = _mm256_set1_ps(coefficients[1]);
+        const __m256 c2 = _mm256_set1_ps(coefficients[2]), c3 = _mm256_set1_ps(coefficients[3]);
+
+        int i = 0;
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            __m256 sum = _mm256_mul_ps(_mm256_loadu_ps(taps + i), c0);
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(taps + i + 1), c1));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(taps + i + 2), c2));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(taps + i + 3), c3));
+            _mm256_storeu_ps(dest + i, sum);
+        }
+
+        _mm256_zeroupper();
+        cubicFirScalar(dest, taps, coefficients, i, numSamples);
+    }
+
+    DSP_KERNEL_TARGET("avx2")
+    __m256 fastLog2Avx2(__m256 x) noexcept
+    {
+        const __m256i bits = _mm256_castps_si256(x);
+        const __m256 exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127)));
+        const __m256 mantissa = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f800000)));
+        const __m256 r = _mm256_sub_ps(mantissa, _mm256_set1_ps(1.0f));
+
+        __m256 poly = _mm256_add_ps(_mm256_set1_ps(log2C4), _mm256_mul_ps(r, _mm256_set1_ps(log2C5)));
+        poly = _mm256_add_ps(_mm256_set1_ps(log2C3), _mm256_mul_ps(r, poly));
+        poly = _mm256_add_ps(_mm256_set1_ps(log2C2), _mm256_mul_ps(r, poly));
+        poly = _mm256_add_ps(_mm256_set1_ps(log2C1), _mm256_mul_ps(r, poly));
+        return _mm256_add_ps(exponent, _mm256_mul_ps(r, poly));
+    }
+
+    DSP_KERNEL_TARGET("avx2")
+    void powerToDecibelsAvx2(float* destDb, const float* complexBins, float scale, float minDb, int numBins)
+    {
+        const __m256 scaleVec = _mm256_set1_ps(scale);
+        const __m256 floorPower = _mm256_set1_ps(smallestPower);
+        const __m256 floorDb = _mm256_set1_ps(minDb);
+        const __m256 dbPerOctave = _mm256_set1_ps(decibelsPerOctave);
+
+        int bin = 0;
+        for (; bin + 8 <= numBins; bin += 8)
+        {
+            const __m256 a = _mm256_loadu_ps(complexBins + bin * 2);
+            const __m256 b = _mm256_loadu_ps(complexBins + bin * 2 + 8);
+
+            // Shuffles stay inside 128-bit halves, giving bins 0 1 4 5 2 3 6 7. The permute puts them back in order
+            const __m256 real = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m256 imag = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            const __m256 power = _mm256_max_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(real, real), _mm256_mul_ps(imag, imag)), scaleVec), floorPower);
+            const __m256 decibels = _mm256_max_ps(_mm256_mul_ps(dbPerOctave, fastLog2Avx2(power)), floorDb);
+            _mm256_storeu_ps(destDb + bin, _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(decibels), _MM_SHUFFLE(3, 1, 2, 0))));
+        }
+
+        _mm256_zeroupper();
+        powerToDecibelsScalar(destDb, complexBins, scale, minDb, bin, numBins);
+    }
+
+    DSP_KERNEL_TARGET("avx2")
+    void decibelsFromPowerAvx2(float* destDb, const float* power, float minDb, int numValues)
+    {
+        const __m256 floorPower = _mm256_set1_ps(smallestPower);
+        const __m256 floorDb = _mm256_set1_ps(minDb);
+        const __m256 dbPerOctave = _mm256_set1_ps(decibelsPerOctave);
+
+        int i = 0;
+        for (; i + 8 <= numValues; i += 8)
+        {
+            const __m256 value = _mm256_max_ps(_mm256_loadu_ps(power + i), floorPower);
+            _mm256_storeu_ps(destDb + i, _mm256_max_ps(_mm256_mul_ps(dbPerOctave, fastLog2Avx2(value)), floorDb));
+        }
+
+        _mm256_zeroupper();
+        decibelsFromPowerScalar(destDb, power, minDb, i, numValues);
+    }
+
+    // === AVX-512 ===
+
+    // Mask for the first numLanes lanes, clamped to [0, 16]
+    __mmask16 firstLanes(int numLanes) noexcept
+    {
+        if (numLanes <= 0)  return 0;
+        if (numLanes >= 16) return 0xffff;
+        return (__mmask16)((1u << numLanes) - 1u);
+    }
+
+    DSP_KERNEL_TARGET("avx512f")
+    void multiplyAvx512(float* data, const float* gains, int numSamples)
+    {
+        int i = 0;
+        for (; i + 16 <= numSamples; i += 16)
+            _mm512_storeu_ps(data + i, _mm512_mul_ps(_mm512_loadu_ps(data + i), _mm512_loadu_ps(gains + i)));
+
+        if (i < numSamples) // Masked tail
+        {
+            const __mmask16 tail = (__mmask16)((1u << (numSamples - i)) - 1u);
+            _mm512_mask_storeu_ps(data + i, tail, _mm512_mul_ps(_mm512_maskz_loadu_ps(tail, data + i), _mm512_maskz_loadu_ps(tail, gains + i)));
+        }
+    }
+
+    DSP_KERNEL_TARGET("avx512f")
+    void cubicFirAvx512(float* dest, const float* taps, const float* coefficients, int numSamples)
+    {
+        const __m512 c0 = _mm512_set1_ps(coefficients[0]), c1 = _mm512_set1_ps(coefficients[1]);
+        const __m512 c2 = _mm512_set1_ps(coefficients[2]), c3 = _mm512_set1_ps(coefficients[3]);
+
+        for (int i = 0; i < numSamples; i += 16)
+        {
+            const __mmask16 lanes = firstLanes(numSamples - i); // All 16 except on a short last pass
+
+            __m512 sum = _mm512_mul_ps(_mm512_maskz_loadu_ps(lanes, taps + i), c0);
+            sum = _mm512_add_ps(sum, _mm512_mul_ps(_mm512_maskz_loadu_ps(lanes, taps + i + 1), c1));
+            sum = _mm512_add_ps(sum, _mm512_mul_ps(_mm512_maskz_loadu_ps(lanes, taps + i + 2), c2));
+            sum = _mm512_add_ps(sum, _mm512_mul_ps(_mm512_maskz_loadu_ps(lanes, taps + i + 3), c3));
+            _mm512_mask_storeu_ps(dest + i, lanes, sum);
+        }
+    }
+
+    DSP_KERNEL_TARGET("avx512f")
+    __m512 fastLog2Avx512(__m512 x) noexcept
+    {
+        const __m512i bits = _mm512_castps_si512(x);
+        const __m512 exponent = _mm512_cvtepi32_ps(_mm512_sub_epi32(_mm512_srli_epi32(bits, 23), _mm512_set1_epi32(127)));
+        const __m512 mantissa = _mm512_castsi512_ps(_mm512_or_si512(_mm512_and_si512(bits, _mm512_set1_epi32(0x007fffff)), _mm512_set1_epi32(0x3f800000)));
+        const __m512 r = _mm512_sub_ps(mantissa, _mm512_set1_ps(1.0f));
+
+        __m512 poly = _mm512_add_ps(_mm512_set1_ps(log2C4), _mm512_mul_ps(r, _mm512_set1_ps(log2C5)));
+        poly = _mm512_add_ps(_mm512_set1_ps(log2C3), _mm512_mul_ps(r, poly));
+        poly = _mm512_add_ps(_mm512_set1_ps(log2C2), _mm512_mul_ps(r, poly));
+        poly = _mm512_add_ps(_mm512_set1_ps(log2C1), _mm512_mul_ps(r, poly));
+        return _mm512_add_ps(exponent, _mm512_mul_ps(r, poly));
+    }
+
+    DSP_KERNEL_TARGET("avx512f")
+    void powerToDecibelsAvx512(float* destDb, const float* complexBins, float scale, float minDb, int numBins)
+    {
+        const __m512 scaleVec = _mm512_set1_ps(scale);
+        const __m512 floorPower = _mm512_set1_ps(smallestPower);
+        const __m512 floorDb = _mm512_set1_ps(minDb);
+        const __m512 dbPerOctave = _mm512_set1_ps(decibelsPerOctave);
+        const __m512i realIndex = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+        const __m512i imagIndex = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+
+        for (int bin = 0; bin < numBins; bin += 16)
+        {
+            const int numFloats = (numBins - bin) * 2;
+            const __m512 a = _mm512_maskz_loadu_ps(firstLanes(numFloats), complexBins + bin * 2);
+            const __m512 b = _mm512_maskz_loadu_ps(firstLanes(numFloats - 16), complexBins + bin * 2 + 16);
+            const __m512 real = _mm512_permutex2var_ps(a, realIndex, b);
+            const __m512 imag = _mm512_permutex2var_ps(a, imagIndex, b);
+            const __m512 power = _mm512_max_ps(_mm512_mul_ps(_mm512_add_ps(_mm512_mul_ps(real, real), _mm512_mul_ps(imag, imag)), scaleVec), floorPower);
+            _mm512_mask_storeu_ps(destDb + bin, firstLanes(numBins - bin), _mm512_max_ps(_mm512_mul_ps(dbPerOctave, fastLog2Avx512(power)), floorDb));
+        }
+    }
+
+    DSP_KERNEL_TARGET("avx512f")
+    void decibelsFromPowerAvx512(float* destDb, const float* power, float minDb, int numValues)
+    {
+        const __m512 floorPower = _mm512_set1_ps(smallestPower);
+        const __m512 floorDb = _mm512_set1_ps(minDb);
+        const __m512 dbPerOctave = _mm512_set1_ps(decibelsPerOctave);
+
+        for (int i = 0; i < numValues; i += 16)
+        {
+            const __mmask16 lanes = firstLanes(numValues - i);
+            const __m512 value = _mm512_max_ps(_mm512_maskz_loadu_ps(lanes, power + i), floorPower);
+            _mm512_mask_storeu_ps(destDb + i, lanes, _mm512_max_ps(_mm512_mul_ps(dbPerOctave, fastLog2Avx512(value)), floorDb));
+        }
+    }
+   #endif
+
+    const DspKernels genericKernels { SimdLevel::generic, multiplyGeneric, cubicFirGeneric, powerToDecibelsGeneric, decibelsFromPowerGeneric };
+
+   #if JUCE_INTEL
+    const DspKernels sse2Kernels    { SimdLevel::sse2,    multiplySse2,    cubicFirSse2,    powerToDecibelsSse2,   decibelsFromPowerSse2 };
+    const DspKernels avx2Kernels    { SimdLevel::avx2,    multiplyAvx2,    cubicFirAvx2,    powerToDecibelsAvx2,   decibelsFromPowerAvx2 };
+    const DspKernels avx512Kernels  { SimdLevel::avx512,  multiplyAvx512,  cubicFirAvx512,  powerToDecibelsAvx512, decibelsFromPowerAvx512 };
+   #endif
+}
+
+const DspKernels& DspKernels::forLevel(SimdLevel requestedLevel)
+{
+    const auto level = juce::jmin(requestedLevel, getHighestSupportedLevel());
+
+   #if JUCE_INTEL
+    switch (level)
+    {
+        case SimdLevel::avx512: return avx512Kernels;
+        case SimdLevel::avx2:   return avx2Kernels;
+        case SimdLevel::sse2:   return sse2Kernels;
+        case SimdLevel::generic: break;
+    }
+   #endif
+
+    juce::ignoreUnused(level);
+    return genericKernels;
+}
+
+SimdLevel DspKernels::getDefaultLevel()
+{
+    const auto forced = juce::SystemStats::getEnvironmentVariable("MULTIEFFECT_SIMD_LEVEL", {}).trim().toLowerCase();
+
+    for (auto level : { SimdLevel::generic, SimdLevel::sse2, SimdLevel::avx2, SimdLevel::avx512 })
+        if (forced == getLevelName(level))
+            return level;
+
+    return getHighestSupportedLevel();
+}
+
+SimdLevel DspKernels::getHighestSupportedLevel()
+{
+   #if JUCE_INTEL
+    if (juce::SystemStats::hasAVX512F()) return SimdLevel::avx512;
+    if (juce::SystemStats::hasAVX2())    return SimdLevel::avx2;
+    return SimdLevel::sse2; // Baseline on every x86-64 CPU
+   #else
+    return SimdLevel::generic;
+   #endif
+}
+
+const char* DspKernels::getLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+        case SimdLevel::sse2:   return "sse2";
+        case SimdLevel::avx2:   return "avx2";
+        case SimdLevel::avx512: return "avx512";
+        case SimdLevel::generic: break;
+    }
+
+    return "generic";
+}
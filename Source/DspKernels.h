@@ -0,0 +1,51 @@
+#pragma once
+#include <JuceHeader.h>
+
+// Instruction set a kernel table was built for. generic is FloatVectorOperations, used off x86
+enum class SimdLevel
+{
+    generic,
+    sse2,
+    avx2,
+    avx512
+};
+
+//==============================================================================
+/**
+    Table of float hot-loop kernels for one instruction set.
+
+    The plugin is built for the lowest common instruction set, so the AVX2 and
+    AVX-512 versions are compiled with per-function target attributes and only
+    picked when the CPU reports them. The processor picks a table once, at
+    construction, and hands it to the chains; nothing is checked per call.
+
+    Set MULTIEFFECT_SIMD_LEVEL to generic, sse2, avx2 or avx512 to force a level,
+    e.g. to compare variants on one machine. Requests above what the CPU
+    supports fall back to the highest supported level.
+*/
+struct DspKernels
+{
+    SimdLevel level;
+
+    // data[i] *= gains[i]
+    void (*multiply)(float* data, const float* gains, int numSamples);
+
+    // dest[i] = taps[i] * c[0] + taps[i + 1] * c[1] + taps[i + 2] * c[2] + taps[i + 3] * c[3]. taps holds numSamples + 3 values
+    void (*cubicFir)(float* dest, const float* taps, const float* coefficients, int numSamples);
+
+    // destDb[bin] = max(10 * log10((re * re + im * im) * scale), minDb), from interleaved re/im pairs as
+    // JUCE's real-only FFT writes them. One pass; log10 is a polynomial approximation within 1e-4 dB
+    void (*powerToDecibels)(float* destDb, const float* complexBins, float scale, float minDb, int numBins);
+
+    // destDb[i] = max(10 * log10(power[i]), minDb). Same approximation as powerToDecibels
+    void (*decibelsFromPower)(float* destDb, const float* power, float minDb, int numValues);
+
+    // Table for a level, clamped to what this CPU supports
+    static const DspKernels& forLevel(SimdLevel requestedLevel);
+
+    // Highest supported level, or the MULTIEFFECT_SIMD_LEVEL override if set
+    static SimdLevel getDefaultLevel();
+
+    static SimdLevel getHighestSupportedLevel();
+    static const char* getLevelName(SimdLevel level);
+};
@@ -0,0 +1,440 @@
+#include "EffectChain.h"
+
+template <typename SampleType>
+void EffectChain<SampleType>::prepare(double newSampleRate, int newNumChannels, int maximumTileSize)
+{
+    sampleRate = newSampleRate;
+    numChannels = newNumChannels;
+
+    auto delayBufferSize = sampleRate * 2.5; // At least 2.5 seconds of sample time, rounded up to a power of two
+
+    // Pack channels into SIMD lanes when they fill a whole register (stereo double, quad float). A half-empty
+    // frame loses to the planar block FIR on settled delays, so stereo float stays planar unless asked otherwise
+   #if JUCE_USE_SIMD
+    constexpr int lanes = InterleavedDelayLine<SampleType>::maxChannels;
+    const bool fitsInterleaved = numChannels > 1 && numChannels <= lanes;
+    useInterleavedDelay = fitsInterleaved && (delayLayout == DelayLayout::interleaved
+                                              || (delayLayout == DelayLayout::automatic && numChannels == lanes));
+    interleavedDelayLine.prepare(useInterleavedDelay ? numChannels : 0, useInterleavedDelay ? (int)delayBufferSize : 0);
+   #endif
+    delayLine.prepare(useInterleavedDelay ? 0 : numChannels, useInterleavedDelay ? 0 : (int)delayBufferSize);
+
+    delayReadScratch.assign((size_t)maximumTileSize, 0);     // Scratch for the constant-delay path
+    delayWriteScratch.assign((size_t)maximumTileSize, 0);
+    delayTapScratch.assign((size_t)maximumTileSize + 3, 0);
+
+    inGainStage.prepare(sampleRate, maximumTileSize, 0.05);
+    outGainStage.prepare(sampleRate, maximumTileSize, 0.05);
+
+    delayTimeSmoothed.prepare(sampleRate, 0.2, numChannels, maximumTileSize);
+	delayFeedbackSmoothed.prepare(sampleRate, 0.05, numChannels, maximumTileSize);
+
+    // Compressor
+	juce::dsp::ProcessSpec spec;
+	spec.maximumBlockSize = (juce::uint32)maximumTileSize;
+	spec.sampleRate = sampleRate;
+	spec.numChannels = (juce::uint32)numChannels;
+	compressor.prepare(spec);
+    compressor.reset();
+}
+
+template <typename SampleType>
+void EffectChain<SampleType>::setParameters(float inGainDb, float outGainDb, float delayTimeSeconds, float delayFeedback)
+{
+    inGainStage.setTargetDecibels(inGainDb);
+	outGainStage.setTargetDecibels(outGainDb);
+
+	delayFeedbackSmoothed.setTargetValue((SampleType)delayFeedback);
+	delayTimeSmoothed.setTargetValue((SampleType)delayTimeSeconds);
+}
+
+// In gain -> delay -> compressor -> out gain on one tile
+template <typename SampleType>
+void EffectChain<SampleType>::processTile(const juce::dsp::AudioBlock<SampleType>& tile)
+{
+    // === INGAIN AND DELAY PROCESSING ===
+
+   #if JUCE_USE_SIMD
+    if (useInterleavedDelay)
+        processInGainAndDelayInterleaved(tile); // All channels per frame in one register
+    else
+   #endif
+        processInGainAndDelayPlanar(tile);
+
+    // === COMPRESSOR PROCESSING ===
+
+    auto context = juce::dsp::ProcessContextReplacing<SampleType>(tile); // Create process context
+    compressor.process(context);
+
+	// === OUTGAIN PROCESSING ===
+
+    outGainStage.process(tile);
+}
+
+// In gain and delay one channel at a time, with block FIR and span copies for settled delays
+template <typename SampleType>
+void EffectChain<SampleType>::processInGainAndDelayPlanar(const juce::dsp::AudioBlock<SampleType>& tile)
+{
+    const int numTileChannels = (int)tile.getNumChannels();
+    const int tileSize = (int)tile.getNumSamples();
+
+    // === INGAIN PROCESSING ===
+
+    inGainStage.process(tile); // Block ramp, no per-sample pow()
+
+    // === DELAY PROCESSING ===
+
+    // For EACH CHANNEL:
+    for (int channel = 0; channel < juce::jmin(numTileChannels, delayLine.getNumChannels()); ++channel)
+    {
+        auto* channelData = tile.getChannelPointer((size_t)channel);
+
+        if (!delayTimeSmoothed.isSettled(channel))
+        {
+            processDelayRamping(channel, channelData, tileSize); // Delay time moving, per-sample path
+            continue;
+        }
+
+        SampleType delayTime = delayTimeSmoothed.getTargetValue(); // Settled, constant for the whole tile
+
+        if (delayTime <= 0)
+        {
+            delayLine.write(channel, channelData, tileSize); // No delay operation, copy to delay line
+            delayFeedbackSmoothed.skip(channel, tileSize);  // Keep feedback ramp in time
+        }
+        else
+            processDelayConstant(channel, channelData, tileSize, delayTime * sampleRate);
+    }
+    delayLine.advance(tileSize); // Increment delay line writePos by amount of tile copied to delay line
+}
+
+// Delay with a moving delay time. A linear ramp changes sign at most once, so the tile is at most
+// one bypass run and one interpolated run, each handled by a kernel with no per-sample branch on it
+template <typename SampleType>
+void EffectChain<SampleType>::processDelayRamping(int channel, SampleType* channelData, int numSamples)
+{
+    const auto* delayTimes = delayTimeSmoothed.getNextBlock(channel, numSamples);         // Per-sample ramps
+    const auto* feedbackGains = delayFeedbackSmoothed.getNextBlock(channel, numSamples);
+    const int split = findDelaySignChange(delayTimes, numSamples);
+
+    if (delayTimes[0] > 0)
+    {
+        processDelayRun<DelayMode::cubic>(channel, channelData, 0, split, delayTimes, feedbackGains);
+        processDelayRun<DelayMode::bypass>(channel, channelData, split, numSamples, delayTimes, feedbackGains);
+    }
+    else
+    {
+        processDelayRun<DelayMode::bypass>(channel, channelData, 0, split, delayTimes, feedbackGains);
+        processDelayRun<DelayMode::cubic>(channel, channelData, split, numSamples, delayTimes, feedbackGains);
+    }
+}
+
+// Samples [start, end) of a ramping delay: read position and interpolation recomputed every sample
+template <typename SampleType>
+template <DelayMode Mode>
+void EffectChain<SampleType>::processDelayRun(int channel, SampleType* channelData, int start, int end,
+                                              const SampleType* delayTimes, const SampleType* feedbackGains)
+{
+    static_assert(Mode == DelayMode::bypass || Mode == DelayMode::cubic, "Settled delays go through processDelayConstant");
+
+    if (start >= end)
+        return;
+
+    if constexpr (Mode == DelayMode::bypass)
+    {
+        delayLine.write(channel, channelData + start, end - start, start); // No delay operation, copy to delay line
+    }
+    else
+    {
+        const int writePosition = delayLine.getWritePosition();
+        const int delayMask = delayLine.getMask();
+
+        const auto* delayData = delayLine.getReadPointer(channel);
+        auto writeSpan = delayLine.getWriteSpan(channel, end - start, start); // Split at the wrap point
+
+        SampleType* writeSegments[] = { writeSpan.data1, writeSpan.data2 };
+        int segmentSizes[] = { writeSpan.size1, writeSpan.size2 };
+        int sample = start;
+
+        // For EACH CONTIGUOUS SEGMENT:
+        for (int segment = 0; segment < 2; ++segment)
+        {
+            auto* writeData = writeSegments[segment];
+
+            // For EACH SAMPLE:
+            for (int i = 0; i < segmentSizes[segment]; ++i, ++sample) {
+
+                // Get main read position, wrapped by mask
+                double readPos = (writePosition + sample) - (delayTimes[sample] * sampleRate);
+                int readPosInt = static_cast<int>(std::floor(readPos));
+
+                SampleType frac = (SampleType)(readPos - readPosInt); // Fraction from readPos to nextReadPos
+
+                // Cubic interpolate
+                SampleType delayedSample = CubicInterpolator::interpolate(delayData[(readPosInt - 1) & delayMask],
+                                                                          delayData[readPosInt & delayMask],
+                                                                          delayData[(readPosInt + 1) & delayMask],
+                                                                          delayData[(readPosInt + 2) & delayMask], frac);
+
+                // Write dry + delayedSample to delay buffer
+                writeData[i] = channelData[sample] + (delayedSample * feedbackGains[sample]);
+
+                // Mix delayedSample into output
+                channelData[sample] += delayedSample;
+            }
+        }
+    }
+}
+
+// Delay with a settled delay time: the fractional offset is fixed, so the interpolator is a 4-tap FIR
+// run over contiguous chunks with FloatVectorOperations. Integer delays mix straight from the ring.
+template <typename SampleType>
+void EffectChain<SampleType>::processDelayConstant(int channel, SampleType* channelData, int numSamples, double delayInSamples)
+{
+    const int writePosition = delayLine.getWritePosition();
+    const double readPosBase = writePosition - delayInSamples;
+    const int readPosInt = static_cast<int>(std::floor(readPosBase));
+    const SampleType frac = (SampleType)(readPosBase - readPosInt);
+    const int lag = writePosition - readPosInt; // Distance from read head back to write head
+    const bool isIntegerDelay = (frac == 0);
+
+    // Every tap must already be written before the chunk starts, which caps the chunk length
+    const int maxChunk = juce::jmin(isIntegerDelay ? lag : lag - 2, (int)delayReadScratch.size());
+
+    if (maxChunk < 1)
+    {
+        processDelayRamping(channel, channelData, numSamples); // Delay shorter than the taps, needs per-sample feedback
+        return;
+    }
+
+    SampleType coefficients[4];
+    CubicInterpolator::getCoefficients(frac, coefficients);
+
+    auto* delayed = delayReadScratch.data();
+    auto* taps = delayTapScratch.data();
+
+    // For EACH CHUNK:
+    for (int start = 0; start < numSamples; start += maxChunk)
+    {
+        const int numThisChunk = juce::jmin(maxChunk, numSamples - start);
+
+        if (isIntegerDelay)
+        {
+            // The taps are the ring itself. The chunk cap keeps every read behind this chunk's writes
+            const auto span = delayLine.getReadSpan(channel, lag - start, numThisChunk);
+            mixDelayed(channel, channelData + start, span.data1, span.size1, start);
+            mixDelayed(channel, channelData + start + span.size1, span.data2, span.size2, start + span.size1);
+            continue;
+        }
+
+        // Gather prev/current/next/next-next taps contiguously, then apply the fixed FIR
+        delayLine.read(channel, lag + 1 - start, taps, numThisChunk + 3);
+
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            kernels->cubicFir(delayed, taps, coefficients, numThisChunk);
+        }
+        else
+        {
+            juce::FloatVectorOperations::multiply(delayed, taps, coefficients[0], numThisChunk);
+            juce::FloatVectorOperations::addWithMultiply(delayed, taps + 1, coefficients[1], numThisChunk);
+            juce::FloatVectorOperations::addWithMultiply(delayed, taps + 2, coefficients[2], numThisChunk);
+            juce::FloatVectorOperations::addWithMultiply(delayed, taps + 3, coefficients[3], numThisChunk);
+        }
+
+        mixDelayed(channel, channelData + start, delayed, numThisChunk, start);
+    }
+}
+
+// Write dry + delayed * feedback into the ring, offset samples past the write position, then mix delayed into the output
+template <typename SampleType>
+void EffectChain<SampleType>::mixDelayed(int channel, SampleType* channelData, const SampleType* delayed, int numSamples, int offset)
+{
+    if (numSamples == 0)
+        return;
+
+    auto* feedback = delayWriteScratch.data();
+    juce::FloatVectorOperations::copy(feedback, channelData, numSamples);
+
+    if (delayFeedbackSmoothed.isSettled(channel))
+    {
+        juce::FloatVectorOperations::addWithMultiply(feedback, delayed, delayFeedbackSmoothed.getTargetValue(), numSamples);
+    }
+    else
+    {
+        const auto* feedbackGains = delayFeedbackSmoothed.getNextBlock(channel, numSamples);
+        juce::FloatVectorOperations::addWithMultiply(feedback, delayed, feedbackGains, numSamples);
+    }
+
+    delayLine.write(channel, feedback, numSamples, offset);
+
+    // Mix delayed into output
+    juce::FloatVectorOperations::add(channelData, delayed, numSamples);
+}
+
+#if JUCE_USE_SIMD
+// In gain and delay with each frame's channels packed into one SIMDRegister. Every channel shares the same
+// parameters, so the smoothers' channel 0 ramps drive all lanes and the tap/interpolation math runs once per frame.
+// The delay mode is worked out here once per tile and the matching kernel instantiation does the frames.
+template <typename SampleType>
+void EffectChain<SampleType>::processInGainAndDelayInterleaved(const juce::dsp::AudioBlock<SampleType>& tile)
+{
+    const int tileSize = (int)tile.getNumSamples();
+    const bool delaySettled = delayTimeSmoothed.isSettled(0);
+
+    DelayKernelInputs inputs;
+    inputs.inGains = inGainStage.getNextGains(tileSize);
+    inputs.delayTimes = delayTimeSmoothed.getNextBlock(0, tileSize);
+    inputs.feedbackGains = delayFeedbackSmoothed.getNextBlock(0, tileSize);
+
+    if (delaySettled)
+    {
+        const SampleType delayTime = delayTimeSmoothed.getTargetValue();
+
+        if (delayTime <= 0)
+        {
+            runInterleavedKernel<DelayMode::bypass>(tile, 0, tileSize, inputs);
+        }
+        else
+        {
+            // Same offset for every frame, so the lag and FIR weights are found once
+            const double readPosBase = -(delayTime * sampleRate);
+            const int readPosInt = static_cast<int>(std::floor(readPosBase));
+            const SampleType frac = (SampleType)(readPosBase - readPosInt);
+            inputs.lag = -readPosInt;
+
+            if (frac == 0)
+            {
+                runInterleavedKernel<DelayMode::integer>(tile, 0, tileSize, inputs);
+            }
+            else
+            {
+                CubicInterpolator::getCoefficients(frac, inputs.coefficients);
+                runInterleavedKernel<DelayMode::cubicFixed>(tile, 0, tileSize, inputs);
+            }
+        }
+    }
+    else
+    {
+        const int split = findDelaySignChange(inputs.delayTimes, tileSize);
+
+        if (inputs.delayTimes[0] > 0)
+        {
+            runInterleavedKernel<DelayMode::cubic>(tile, 0, split, inputs);
+            runInterleavedKernel<DelayMode::bypass>(tile, split, tileSize, inputs);
+        }
+        else
+        {
+            runInterleavedKernel<DelayMode::bypass>(tile, 0, split, inputs);
+            runInterleavedKernel<DelayMode::cubic>(tile, split, tileSize, inputs);
+        }
+    }
+
+    interleavedDelayLine.advance(tileSize);
+}
+
+// Channel count becomes a template argument, so the interleave loops unroll
+template <typename SampleType>
+template <DelayMode Mode>
+void EffectChain<SampleType>::runInterleavedKernel(const juce::dsp::AudioBlock<SampleType>& tile, int start, int end, const DelayKernelInputs& inputs)
+{
+    constexpr int maxLanes = InterleavedDelayLine<SampleType>::maxChannels;
+
+    if (start >= end)
+        return;
+
+    switch (juce::jmin((int)tile.getNumChannels(), interleavedDelayLine.getNumChannels()))
+    {
+        case 1:  interleavedKernel<1, Mode>(tile, start, end, inputs); break;
+        case 2:  interleavedKernel<2, Mode>(tile, start, end, inputs); break;
+        case 3:  if constexpr (maxLanes >= 3) interleavedKernel<3, Mode>(tile, start, end, inputs); break;
+        case 4:  if constexpr (maxLanes >= 4) interleavedKernel<4, Mode>(tile, start, end, inputs); break;
+        default: jassertfalse; break; // prepare() never interleaves more channels than a SIMDRegister holds
+    }
+}
+
+// Frames [start, end) for a fixed lane count and delay mode
+template <typename SampleType>
+template <int NumLanes, DelayMode Mode>
+void EffectChain<SampleType>::interleavedKernel(const juce::dsp::AudioBlock<SampleType>& tile, int start, int end, const DelayKernelInputs& inputs)
+{
+    using Frame = typename InterleavedDelayLine<SampleType>::Frame;
+
+    const int writePosition = interleavedDelayLine.getWritePosition();
+    const int delayMask = interleavedDelayLine.getMask();
+    auto* delayFrames = interleavedDelayLine.getFrames();
+
+    alignas(Frame::SIMDRegisterSize) SampleType lanes[Frame::SIMDNumElements] = {};
+    SampleType* channels[NumLanes];
+
+    for (int channel = 0; channel < NumLanes; ++channel)
+        channels[channel] = tile.getChannelPointer((size_t)channel);
+
+    // For EACH FRAME:
+    for (int sample = start; sample < end; ++sample)
+    {
+        // Interleave and apply in gain
+        for (int channel = 0; channel < NumLanes; ++channel)
+            lanes[channel] = channels[channel][sample];
+
+        const Frame dry = Frame::fromRawArray(lanes) * inputs.inGains[sample];
+        Frame& writeFrame = delayFrames[(writePosition + sample) & delayMask];
+
+        if constexpr (Mode == DelayMode::bypass)
+        {
+            writeFrame = dry; // No delay operation
+            dry.copyToRawArray(lanes);
+        }
+        else
+        {
+            Frame delayed;
+
+            if constexpr (Mode == DelayMode::integer)
+            {
+                delayed = delayFrames[(writePosition + sample - inputs.lag) & delayMask]; // Single tap
+            }
+            else
+            {
+                int readPosInt = writePosition + sample - inputs.lag;
+                const SampleType* coefficients = inputs.coefficients;
+                SampleType frameCoefficients[4];
+
+                if constexpr (Mode == DelayMode::cubic)
+                {
+                    double readPos = (writePosition + sample) - (inputs.delayTimes[sample] * sampleRate);
+                    readPosInt = static_cast<int>(std::floor(readPos));
+
+                    CubicInterpolator::getCoefficients((SampleType)(readPos - readPosInt), frameCoefficients); // Once per frame for all lanes
+                    coefficients = frameCoefficients;
+                }
+
+                delayed = (delayFrames[(readPosInt - 1) & delayMask] * coefficients[0])
+                        + (delayFrames[readPosInt & delayMask] * coefficients[1])
+                        + (delayFrames[(readPosInt + 1) & delayMask] * coefficients[2])
+                        + (delayFrames[(readPosInt + 2) & delayMask] * coefficients[3]);
+            }
+
+            writeFrame = dry + (delayed * inputs.feedbackGains[sample]);
+            (dry + delayed).copyToRawArray(lanes);
+        }
+
+        // De-interleave
+        for (int channel = 0; channel < NumLanes; ++channel)
+            channels[channel][sample] = lanes[channel];
+    }
+}
+#endif
+
+// Ramps are linear, so the delay time is split into one run above zero and one at or below it
+template <typename SampleType>
+int EffectChain<SampleType>::findDelaySignChange(const SampleType* delayTimes, int numSamples)
+{
+    const bool startsDelayed = delayTimes[0] > 0;
+
+    return (int)(std::partition_point(delayTimes, delayTimes + numSamples,
+                                      [startsDelayed](SampleType delayTime) { return (delayTime > 0) == startsDelayed; })
+                 - delayTimes);
+}
+
+template class EffectChain<float>;
+template class EffectChain<double>;
@@ -0,0 +1,120 @@
+#pragma once
+#include <JuceHeader.h>
+#include "BlockSmoother.h"
+#include "GainStage.h"
+#include "DelayLine.h"
+#include "InterleavedDelayLine.h"
+#include "DelayInterpolation.h"
+#include "DspKernels.h"
+
+//==============================================================================
+// How the delay line stores its channels
+enum class DelayLayout
+{
+    automatic,  // Interleaved when the channels fill a SIMDRegister, planar otherwise
+    planar,     // One ring per channel (DelayLine)
+    interleaved // One SIMDRegister frame per sample (InterleavedDelayLine). Needs 2 to SIMDNumElements channels
+};
+
+//==============================================================================
+/**
+    In gain -> delay -> compressor -> out gain, for one sample type.
+
+    The processor owns a float and a double instance and prepares the one
+    matching the host's processing precision, so both paths share this code.
+    processTile() expects tiles of at most the size given to prepare().
+    Any channel count works: delay memory, smoothers and compressor state are
+    allocated per channel in prepare(), so cost grows linearly with channels.
+*/
+template <typename SampleType>
+class EffectChain
+{
+public:
+    EffectChain() = default;
+
+    // Takes effect at the next prepare()
+    void setDelayLayout(DelayLayout newLayout) { delayLayout = newLayout; }
+
+    // Allocate delay memory, ramps and scratch. Call from prepareToPlay
+    void prepare(double sampleRate, int numChannels, int maximumTileSize);
+
+    // Per-block parameter targets. Feedback is 0-1
+    void setParameters(float inGainDb, float outGainDb, float delayTimeSeconds, float delayFeedback);
+
+    void setCompressorAttack(float attackMs)       { compressor.setAttack((SampleType)attackMs); }
+    void setCompressorRelease(float releaseMs)     { compressor.setRelease((SampleType)releaseMs); }
+    void setCompressorThreshold(float thresholdDb) { compressor.setThreshold((SampleType)thresholdDb); }
+    void setCompressorRatio(float ratio)           { compressor.setRatio((SampleType)ratio); }
+
+    // Kernel table for the float hot loops. Call while not processing
+    void setKernels(const DspKernels& newKernels)
+    {
+        kernels = &newKernels;
+        inGainStage.setKernels(newKernels);
+        outGainStage.setKernels(newKernels);
+    }
+
+    // Channel count given to prepare(). All per-channel state is sized from it
+    int getNumChannels() const noexcept { return numChannels; }
+
+    // Silence the delay history of a channel with no input
+    void clearDelayChannel(int channel) { delayLine.clear(channel); }
+
+    // Run the whole chain in place on one tile
+    void processTile(const juce::dsp::AudioBlock<SampleType>& tile);
+
+private:
+    // Per-tile values shared by the delay kernels
+    struct DelayKernelInputs
+    {
+        const SampleType* inGains = nullptr;
+        const SampleType* delayTimes = nullptr;
+        const SampleType* feedbackGains = nullptr;
+        int lag = 0;                        // Whole samples back to the read head (integer and cubicFixed)
+        SampleType coefficients[4] = {};    // FIR weights (cubicFixed)
+    };
+
+    void processInGainAndDelayPlanar(const juce::dsp::AudioBlock<SampleType>& tile);
+    void processDelayRamping(int channel, SampleType* channelData, int numSamples);
+    template <DelayMode Mode>
+    void processDelayRun(int channel, SampleType* channelData, int start, int end, const SampleType* delayTimes, const SampleType* feedbackGains);
+    void processDelayConstant(int channel, SampleType* channelData, int numSamples, double delayInSamples);
+    void mixDelayed(int channel, SampleType* channelData, const SampleType* delayed, int numSamples, int offset);
+
+   #if JUCE_USE_SIMD
+    void processInGainAndDelayInterleaved(const juce::dsp::AudioBlock<SampleType>& tile);
+    template <DelayMode Mode>
+    void runInterleavedKernel(const juce::dsp::AudioBlock<SampleType>& tile, int start, int end, const DelayKernelInputs& inputs);
+    template <int NumLanes, DelayMode Mode>
+    void interleavedKernel(const juce::dsp::AudioBlock<SampleType>& tile, int start, int end, const DelayKernelInputs& inputs);
+   #endif
+
+    // First sample where the delay time changes sign, or numSamples if it doesn't
+    static int findDelaySignChange(const SampleType* delayTimes, int numSamples);
+
+    double sampleRate{ 44100.0 };
+    int numChannels{ 0 };
+    const DspKernels* kernels{ &DspKernels::forLevel(SimdLevel::generic) };
+
+	// === Gain ===
+    GainStage<SampleType> inGainStage;
+    GainStage<SampleType> outGainStage;
+
+	// === Delay ===
+	BlockSmoother<SampleType> delayFeedbackSmoothed{ 0 };  // One state per channel
+    BlockSmoother<SampleType> delayTimeSmoothed{ 0 };
+    DelayLine<SampleType> delayLine;
+   #if JUCE_USE_SIMD
+    InterleavedDelayLine<SampleType> interleavedDelayLine;  // Used instead of delayLine when useInterleavedDelay is set
+   #endif
+    DelayLayout delayLayout{ DelayLayout::automatic };
+    bool useInterleavedDelay{ false };
+    std::vector<SampleType> delayReadScratch;    // Interpolated delay output for one chunk (fractional delays only)
+    std::vector<SampleType> delayWriteScratch;   // Dry + feedback going back into delayLine
+    std::vector<SampleType> delayTapScratch;     // Contiguous copy of the taps, chunk + 3 long
+
+	// === Compressor ===
+	juce::dsp::Compressor<SampleType> compressor;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EffectChain)
+};
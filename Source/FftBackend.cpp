@@ -0,0 +1,444 @@
+#include "FftBackend.h"
+
+#if JUCE_USE_SIMD
+ #if JUCE_INTEL
+  #include <immintrin.h>
+ #elif JUCE_ARM
+  #include <arm_neon.h>
+ #endif
+#endif
+
+namespace
+{
+    //==============================================================================
+    class JuceFftBackend final : public FftBackend
+    {
+    public:
+        explicit JuceFftBackend(int order) : FftBackend(order), fft(order) {}
+
+        void performComplexForwardTransform(const float* input, float* output) const noexcept override
+        {
+            fft.perform(reinterpret_cast<const juce::dsp::Complex<float>*>(input),
+                        reinterpret_cast<juce::dsp::Complex<float>*>(output), false);
+        }
+
+    private:
+        juce::dsp::FFT fft;
+    };
+
+    //==============================================================================
+    // Iterative radix-2 complex FFT. Bit reversal and stage twiddles come from tables made in the constructor,
+    // so the transform itself has no trig and no recursion.
+    class TableFftBackend final : public FftBackend
+    {
+    public:
+        explicit TableFftBackend(int order) : FftBackend(order), swaps(makeBitReversalSwaps(order))
+        {
+            // Per-stage twiddles stored contiguously: stage with half-length h uses h entries starting at h - 1
+            for (int half = 1; half < size; half *= 2)
+            {
+                for (int j = 0; j < half; ++j)
+                {
+                    const double angle = -juce::MathConstants<double>::pi * j / half;
+                    stageTwiddles.push_back({ (float)std::cos(angle), (float)std::sin(angle) });
+                }
+            }
+        }
+
+        void performComplexForwardTransform(const float* input, float* output) const noexcept override
+        {
+            std::copy(input, input + size * 2, output);
+            transform(reinterpret_cast<Complex*>(output));
+        }
+
+    private:
+        struct Complex { float re, im; };
+
+        // Index pairs to exchange for the bit-reversal permutation
+        struct Swaps { std::vector<int> from, to; };
+
+        static Swaps makeBitReversalSwaps(int bits)
+        {
+            Swaps result;
+
+            for (int i = 0; i < (1 << bits); ++i)
+            {
+                int reversed = 0;
+                for (int bit = 0; bit < bits; ++bit)
+                    reversed |= ((i >> bit) & 1) << (bits - 1 - bit);
+
+                if (i < reversed)
+                {
+                    result.from.push_back(i);
+                    result.to.push_back(reversed);
+                }
+            }
+
+            return result;
+        }
+
+        // In place, on size points
+        void transform(Complex* z) const noexcept
+        {
+            for (size_t i = 0; i < swaps.from.size(); ++i)
+                std::swap(z[swaps.from[i]], z[swaps.to[i]]);
+
+            // For EACH STAGE:
+            for (int half = 1; half < size; half *= 2)
+            {
+                const Complex* twiddles = stageTwiddles.data() + (half - 1);
+
+                // For EACH BUTTERFLY GROUP:
+                for (int start = 0; start < size; start += half * 2)
+                {
+                    Complex* a = z + start;
+                    Complex* b = a + half;
+
+                    for (int j = 0; j < half; ++j)
+                    {
+                        const Complex w = twiddles[j];
+                        const float tRe = (b[j].re * w.re) - (b[j].im * w.im);
+                        const float tIm = (b[j].re * w.im) + (b[j].im * w.re);
+
+                        b[j].re = a[j].re - tRe;
+                        b[j].im = a[j].im - tIm;
+                        a[j].re += tRe;
+                        a[j].im += tIm;
+                    }
+                }
+            }
+        }
+
+        Swaps swaps;
+        std::vector<Complex> stageTwiddles;
+    };
+
+   #if JUCE_USE_SIMD
+    //==============================================================================
+    // Radix-4 Stockham FFT on split re/im arrays, four points to a SIMDRegister, after pffft. Each pass writes
+    // into the other buffer already in order, so there is no bit reversal and every butterfly loads and stores
+    // whole registers. The first pass is the exception: its four points are neighbours, so it vectorises across
+    // four butterflies and transposes their outputs into place. Odd orders finish with one radix-2 pass.
+    class SimdFftBackend final : public FftBackend
+    {
+    public:
+        explicit SimdFftBackend(int order) : FftBackend(order)
+        {
+            static_assert(lanes == 4, "The first pass transposes 4 x 4 blocks");
+            jassert(order >= 4);
+
+            const int numVectors = size / lanes;
+
+            for (auto& buffer : work)
+            {
+                buffer.re.assign((size_t)numVectors, Vec::expand(0.0f));
+                buffer.im.assign((size_t)numVectors, Vec::expand(0.0f));
+            }
+
+            // First pass: butterfly p of size / 4 takes w^p, w^2p and w^3p with w = exp(-2 pi i / size), for four p at once
+            for (int vector = 0; vector < size / 16; ++vector)
+            {
+                alignas(16) float re[3][lanes], im[3][lanes];
+
+                for (int lane = 0; lane < lanes; ++lane)
+                {
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        const double angle = -juce::MathConstants<double>::twoPi * (k + 1) * (vector * lanes + lane) / size;
+                        re[k][lane] = (float)std::cos(angle);
+                        im[k][lane] = (float)std::sin(angle);
+                    }
+                }
+
+                auto& twiddles = firstPassTwiddles.emplace_back();
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    twiddles.re[k] = Vec::fromRawArray(re[k]);
+                    twiddles.im[k] = Vec::fromRawArray(im[k]);
+                }
+            }
+
+            // Later radix-4 passes, stored one after another: length n has n / 4 butterflies, each with a scalar twiddle set
+            for (int length = size / 4; length >= 4; length /= 4)
+            {
+                for (int p = 0; p < length / 4; ++p)
+                {
+                    auto& twiddles = passTwiddles.emplace_back();
+
+                    for (int k = 0; k < 3; ++k)
+                    {
+                        const double angle = -juce::MathConstants<double>::twoPi * (k + 1) * p / length;
+                        twiddles.re[k] = (float)std::cos(angle);
+                        twiddles.im[k] = (float)std::sin(angle);
+                    }
+                }
+            }
+        }
+
+        void performComplexForwardTransform(const float* input, float* output) const noexcept override
+        {
+            // Split the interleaved input into re and im
+            auto* re = reinterpret_cast<float*>(work[0].re.data());
+            auto* im = reinterpret_cast<float*>(work[0].im.data());
+
+            for (int i = 0; i < size; ++i)
+            {
+                re[i] = input[i * 2];
+                im[i] = input[i * 2 + 1];
+            }
+
+            firstPass(work[0], work[1]);
+            int current = 1;
+
+            // For EACH RADIX-4 PASS: length n split at a stride of 4 vectors, then 16, 64 ...
+            const PassTwiddles* twiddles = passTwiddles.data();
+            int length = size / 4;
+
+            for (int stride = 1; length >= 4; length /= 4, stride *= 4)
+            {
+                radix4Pass(work[current], work[current ^ 1], length / 4, stride, twiddles);
+                twiddles += length / 4;
+                current ^= 1;
+            }
+
+            if (length == 2)
+            {
+                radix2Pass(work[current], work[current ^ 1]);
+                current ^= 1;
+            }
+
+            // Interleave the result back into re/im pairs
+            re = reinterpret_cast<float*>(work[current].re.data());
+            im = reinterpret_cast<float*>(work[current].im.data());
+
+            for (int i = 0; i < size; ++i)
+            {
+                output[i * 2] = re[i];
+                output[i * 2 + 1] = im[i];
+            }
+        }
+
+    private:
+        using Vec = juce::dsp::SIMDRegister<float>;
+        static constexpr int lanes = (int)Vec::SIMDNumElements;
+
+        struct Split { std::vector<Vec> re, im; };
+        struct FirstPassTwiddles { Vec re[3], im[3]; };    // w^p, w^2p, w^3p for four neighbouring p
+        struct PassTwiddles { float re[3], im[3]; };
+
+        // Radix-4 decimation in frequency butterfly on a, b, c, d (x[0..3]), written back over them in output order.
+        // Outputs 1 to 3 still need their twiddles
+        static void butterfly(Vec (&re)[4], Vec (&im)[4]) noexcept
+        {
+            const Vec apcRe = re[0] + re[2], apcIm = im[0] + im[2];
+            const Vec amcRe = re[0] - re[2], amcIm = im[0] - im[2];
+            const Vec bpdRe = re[1] + re[3], bpdIm = im[1] + im[3];
+            const Vec bmdRe = re[1] - re[3], bmdIm = im[1] - im[3];
+
+            // a + c + b + d, (a - c) -+ i (b - d) and (a + c) - (b + d)
+            re[0] = apcRe + bpdRe;  im[0] = apcIm + bpdIm;
+            re[1] = amcRe + bmdIm;  im[1] = amcIm - bmdRe;
+            re[2] = apcRe - bpdRe;  im[2] = apcIm - bpdIm;
+            re[3] = amcRe - bmdIm;  im[3] = amcIm + bmdRe;
+        }
+
+        template <typename Twiddle>
+        static void applyTwiddles(Vec (&re)[4], Vec (&im)[4], const Twiddle (&wRe)[3], const Twiddle (&wIm)[3]) noexcept
+        {
+            for (int k = 1; k < 4; ++k)
+                multiply(re[k], im[k], wRe[k - 1], wIm[k - 1]);
+        }
+
+        static void multiply(Vec& re, Vec& im, Vec wRe, Vec wIm) noexcept
+        {
+            const Vec product = (re * wRe) - (im * wIm);
+            im = (re * wIm) + (im * wRe);
+            re = product;
+        }
+
+        // Rows become columns
+        static void transpose(Vec (&rows)[4]) noexcept
+        {
+           #if JUCE_INTEL
+            _MM_TRANSPOSE4_PS(rows[0].value, rows[1].value, rows[2].value, rows[3].value);
+           #elif JUCE_ARM
+            const float32x4x2_t low = vtrnq_f32(rows[0].value, rows[1].value);
+            const float32x4x2_t high = vtrnq_f32(rows[2].value, rows[3].value);
+            rows[0].value = vcombine_f32(vget_low_f32(low.val[0]), vget_low_f32(high.val[0]));
+            rows[1].value = vcombine_f32(vget_low_f32(low.val[1]), vget_low_f32(high.val[1]));
+            rows[2].value = vcombine_f32(vget_high_f32(low.val[0]), vget_high_f32(high.val[0]));
+            rows[3].value = vcombine_f32(vget_high_f32(low.val[1]), vget_high_f32(high.val[1]));
+           #else
+            alignas(16) float values[4][lanes];
+
+            for (int row = 0; row < 4; ++row)
+                for (int column = 0; column < lanes; ++column)
+                    values[column][row] = rows[row][(size_t)column];
+
+            for (int row = 0; row < 4; ++row)
+                rows[row] = Vec::fromRawArray(values[row]);
+           #endif
+        }
+
+        // Length size, stride 1: vector v holds butterflies 4v..4v+3, whose outputs land in vectors 4v..4v+3 once transposed.
+        // The passes work on raw pointers: a store through a SIMD type may alias anything, so the vectors' own
+        // data pointers would be reloaded after every store
+        void firstPass(const Split& x, Split& y) const noexcept
+        {
+            const Vec* xRe = x.re.data();
+            const Vec* xIm = x.im.data();
+            Vec* yRe = y.re.data();
+            Vec* yIm = y.im.data();
+            const int quarter = size / 16;
+
+            for (int vector = 0; vector < quarter; ++vector)
+            {
+                Vec re[4], im[4];
+
+                for (int k = 0; k < 4; ++k)
+                {
+                    re[k] = xRe[vector + quarter * k];
+                    im[k] = xIm[vector + quarter * k];
+                }
+
+                const auto& twiddles = firstPassTwiddles[(size_t)vector];
+                butterfly(re, im);
+                applyTwiddles(re, im, twiddles.re, twiddles.im);
+                transpose(re);
+                transpose(im);
+
+                for (int k = 0; k < 4; ++k)
+                {
+                    yRe[vector * 4 + k] = re[k];
+                    yIm[vector * 4 + k] = im[k];
+                }
+            }
+        }
+
+        // numButterflies sets of stride vectors, a quarter of the pass apart, into 4 runs of stride vectors each
+        void radix4Pass(const Split& x, Split& y, int numButterflies, int stride, const PassTwiddles* twiddles) const noexcept
+        {
+            const Vec* xRe = x.re.data();
+            const Vec* xIm = x.im.data();
+            Vec* yRe = y.re.data();
+            Vec* yIm = y.im.data();
+            const int quarter = numButterflies * stride;
+
+            for (int p = 0; p < numButterflies; ++p)
+            {
+                Vec wRe[3], wIm[3];
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    wRe[k] = Vec::expand(twiddles[p].re[k]);
+                    wIm[k] = Vec::expand(twiddles[p].im[k]);
+                }
+
+                for (int q = 0; q < stride; ++q)
+                {
+                    const int in = q + stride * p;
+                    const int out = q + stride * p * 4;
+                    Vec re[4], im[4];
+
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        re[k] = xRe[in + quarter * k];
+                        im[k] = xIm[in + quarter * k];
+                    }
+
+                    butterfly(re, im);
+
+                    if (p > 0) // Butterfly 0's twiddles are all 1, and it is the only one in the last pass
+                        applyTwiddles(re, im, wRe, wIm);
+
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        yRe[out + stride * k] = re[k];
+                        yIm[out + stride * k] = im[k];
+                    }
+                }
+            }
+        }
+
+        // Length 2, stride size / 2: the last pass of an odd order
+        void radix2Pass(const Split& x, Split& y) const noexcept
+        {
+            const Vec* xRe = x.re.data();
+            const Vec* xIm = x.im.data();
+            Vec* yRe = y.re.data();
+            Vec* yIm = y.im.data();
+            const int half = size / 2 / lanes;
+
+            for (int q = 0; q < half; ++q)
+            {
+                const Vec aRe = xRe[q], aIm = xIm[q], bRe = xRe[q + half], bIm = xIm[q + half];
+                yRe[q] = aRe + bRe;
+                yIm[q] = aIm + bIm;
+                yRe[q + half] = aRe - bRe;
+                yIm[q + half] = aIm - bIm;
+            }
+        }
+
+        std::vector<FirstPassTwiddles> firstPassTwiddles;
+        std::vector<PassTwiddles> passTwiddles;
+        mutable Split work[2];      // Written by every transform, so an instance can't be shared between threads
+    };
+   #endif
+}
+
+void FftBackend::performTwoRealForwardTransforms(const float* pairs, float* firstBins, float* secondBins) const noexcept
+{
+    performComplexForwardTransform(pairs, firstBins);
+
+    // With z = first + i second: First[k] = (Z[k] + conj(Z[N - k])) / 2 and Second[k] = (Z[k] - conj(Z[N - k])) / 2i.
+    // Bin k is written over Z[k], which nothing later reads; Z[N - k] sits above N/2 and is only read here
+    for (int k = 0; k <= size / 2; ++k)
+    {
+        const int mirror = (size - k) & (size - 1);
+
+        const float aRe = firstBins[k * 2];
+        const float aIm = firstBins[k * 2 + 1];
+        const float bRe = firstBins[mirror * 2];
+        const float bIm = firstBins[mirror * 2 + 1];
+
+        secondBins[k * 2] = 0.5f * (aIm + bIm);
+        secondBins[k * 2 + 1] = 0.5f * (bRe - aRe);
+        firstBins[k * 2] = 0.5f * (aRe + bRe);
+        firstBins[k * 2 + 1] = 0.5f * (aIm - bIm);
+    }
+}
+
+std::unique_ptr<FftBackend> FftBackend::create(Type type, int order)
+{
+   #if JUCE_USE_SIMD
+    if (type == Type::simd && order >= 4)
+        return std::make_unique<SimdFftBackend>(order);
+   #endif
+
+    if (type == Type::table || type == Type::simd)
+        return std::make_unique<TableFftBackend>(order);
+
+    return std::make_unique<JuceFftBackend>(order);
+}
+
+FftBackend::Type FftBackend::getDefaultType() noexcept
+{
+    // juce::dsp::FFT on Linux is JUCE's scalar fallback unless juce_dsp is built with FFTW. The simd backend beats
+    // the scalar table FFT at every analyser order, so it takes over there
+   #if JUCE_LINUX && JUCE_USE_SIMD
+    return Type::simd;
+   #else
+    return Type::juce;
+   #endif
+}
+
+const char* FftBackend::getTypeName(Type type) noexcept
+{
+    switch (type)
+    {
+        case Type::table: return "Built-in";
+        case Type::simd:  return "Built-in SIMD";
+        default:          return "JUCE";
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Forward FFT used by the spectrum analyser.
+
+    performTwoRealForwardTransforms() transforms two real signals at once: one
+    goes in as the real part and one as the imaginary part of a single complex
+    FFT, and the two spectra are split apart afterwards using the conjugate
+    symmetry of a real signal's spectrum. Each spectrum comes out in the layout
+    juce::dsp::FFT::performRealOnlyForwardTransform(data, true) writes: bins
+    0..size/2 as interleaved re/im pairs.
+
+    The pair costs one complex FFT of size points plus a linear split pass,
+    which is about what two real FFTs of that size cost, not one. Two real
+    spectra hold as many values as one complex spectrum, so no packing gets
+    them for the price of one real transform. What batching saves is the
+    second call and a second pass over the frame.
+
+    Only the table backend can be shared between threads: its tables never
+    change after construction and a transform writes nothing but the buffers
+    it is given (see FftPlanCache). The others cannot. juce::dsp::FFT engines
+    such as IPP's keep a work buffer in the object and write it on every
+    transform, and so does the simd backend, so each thread needs its own.
+*/
+class FftBackend
+{
+public:
+    enum class Type
+    {
+        juce,       // juce::dsp::FFT: vDSP/IPP/FFTW when JUCE is built with them, otherwise JUCE's fallback
+        table,      // Built-in radix-2 complex FFT with precomputed tables
+        simd        // Built-in radix-4 FFT on SIMDRegisters. The table FFT where JUCE has no SIMD
+    };
+
+    virtual ~FftBackend() = default;
+
+    // Complex FFT of size points, as interleaved re/im pairs. input and output must not overlap
+    virtual void performComplexForwardTransform(const float* input, float* output) const noexcept = 0;
+
+    // pairs holds size pairs of (first[n], second[n]). firstBins (2 * size floats, also used as working space)
+    // gets the first signal's spectrum and secondBins (size + 2 floats) the second's, both in the real transform layout
+    void performTwoRealForwardTransforms(const float* pairs, float* firstBins, float* secondBins) const noexcept;
+
+    int getSize() const noexcept { return size; }
+
+    // Allocates plans and tables. Call off the audio thread
+    static std::unique_ptr<FftBackend> create(Type type, int order);
+
+    // simd on Linux, juce elsewhere. The others are opt-in from the settings menu; compare them with the backend benchmark
+    static Type getDefaultType() noexcept;
+
+    static const char* getTypeName(Type type) noexcept;
+
+protected:
+    explicit FftBackend(int order) : size(1 << order) {}
+
+    const int size;
+
+    JUCE_DECLARE_NON_COPYABLE(FftBackend)
+};
@@ -0,0 +1,26 @@
+#include "FftPlanCache.h"
+
+const FftBackend& FftPlanCache::getTablePlan(int order)
+{
+    const juce::ScopedLock sl(lock);
+    auto& plan = tablePlans[order];
+
+    if (plan == nullptr)
+        plan = FftBackend::create(FftBackend::Type::table, order);
+
+    return *plan;
+}
+
+const float* FftPlanCache::getWindow(WindowType type, int order)
+{
+    const juce::ScopedLock sl(lock);
+    auto& window = windows[{ type, order }];
+
+    if (window.empty())
+    {
+        window.resize((size_t)1 << order);
+        juce::dsp::WindowingFunction<float>::fillWindowingTables(window.data(), window.size(), type);
+    }
+
+    return window.data();
+}
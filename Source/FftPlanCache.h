@@ -0,0 +1,39 @@
+#pragma once
+#include <JuceHeader.h>
+#include "FftBackend.h"
+
+//==============================================================================
+/**
+    Process-wide store of the read-only tables behind the spectrum analyser:
+    table-backend FFT plans keyed by order, windows keyed by type and order.
+
+    Hold it through juce::SharedResourcePointer<FftPlanCache>. Every plugin
+    instance in the process then shares one copy of each table. A table is
+    built the first time any instance asks for it, and everything goes with
+    the last pointer. Nothing in here changes after it is built, so any
+    number of analysis threads can use the same table at once.
+
+    juce and simd plans are not kept here. Both write a work buffer inside the
+    object on every transform, so each analyser builds its own (see
+    FftBackend).
+*/
+class FftPlanCache
+{
+public:
+    using WindowType = juce::dsp::WindowingFunction<float>::WindowingMethod;
+
+    FftPlanCache() = default;
+
+    // A table-backend plan, valid for the cache's lifetime. May build it, so call off the audio thread
+    const FftBackend& getTablePlan(int order);
+
+    // 2^order points, valid for the cache's lifetime. May build the table, so call off the audio thread
+    const float* getWindow(WindowType type, int order);
+
+private:
+    juce::CriticalSection lock;     // Only held while looking up or building
+    std::map<int, std::unique_ptr<FftBackend>> tablePlans;
+    std::map<std::pair<WindowType, int>, std::vector<float>> windows;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FftPlanCache)
+};
@@ -0,0 +1,57 @@
+#include "GainStage.h"
+
+template <typename SampleType>
+void GainStage<SampleType>::prepare(double sampleRate, int maximumBlockSize, double rampLengthSeconds)
+{
+    gainSmoothed.prepare(sampleRate, rampLengthSeconds, 1, maximumBlockSize); // One ramp shared by all channels
+}
+
+template <typename SampleType>
+void GainStage<SampleType>::setTargetDecibels(float newTargetDb)
+{
+    if (newTargetDb == targetDb)
+        return;
+
+    targetDb = newTargetDb;
+    gainSmoothed.setTargetValue(juce::Decibels::decibelsToGain((SampleType)targetDb)); // Only pow() call, once per change
+}
+
+template <typename SampleType>
+void GainStage<SampleType>::process(const juce::dsp::AudioBlock<SampleType>& block)
+{
+    const auto numChannels = (int)block.getNumChannels();
+    const auto numSamples = (int)block.getNumSamples();
+
+    // Constant gain fast path
+    if (gainSmoothed.isSettled())
+    {
+        const SampleType gain = gainSmoothed.getTargetValue();
+
+        if (gain == (SampleType)1) return; // Unity, nothing to do
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::multiply(block.getChannelPointer((size_t)channel), gain, numSamples);
+
+        return;
+    }
+
+    // Ramp: fill in chunks, then multiply each channel by it
+    const int rampSize = gainSmoothed.getMaximumBlockSize();
+
+    for (int start = 0; start < numSamples; start += rampSize)
+    {
+        const int numThisChunk = juce::jmin(rampSize, numSamples - start);
+        const SampleType* gainRamp = gainSmoothed.getNextBlock(0, numThisChunk);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            if constexpr (std::is_same_v<SampleType, float>)
+                kernels->multiply(block.getChannelPointer((size_t)channel) + start, gainRamp, numThisChunk);
+            else
+                juce::FloatVectorOperations::multiply(block.getChannelPointer((size_t)channel) + start, gainRamp, numThisChunk);
+        }
+    }
+}
+
+template class GainStage<float>;
+template class GainStage<double>;
@@ -0,0 +1,44 @@
+#pragma once
+#include <JuceHeader.h>
+#include "BlockSmoother.h"
+#include "DspKernels.h"
+
+//==============================================================================
+/**
+    Smoothed dB gain applied a block at a time.
+
+    The dB target is converted to a linear gain once per change. Ramps are made by a
+    multiplicative BlockSmoother (a straight line in dB), so no pow() runs per sample.
+    Every channel shares the same ramp. Float ramps go through the dispatched
+    DspKernels multiply, doubles through FloatVectorOperations.
+*/
+template <typename SampleType>
+class GainStage
+{
+public:
+    GainStage() = default;
+
+    // Set ramp length and snap to the current target. Call from prepareToPlay
+    void prepare(double sampleRate, int maximumBlockSize, double rampLengthSeconds);
+
+    // Set the gain to ramp towards, in dB. Cheap if unchanged
+    void setTargetDecibels(float newTargetDb);
+
+    // Multiply every channel of the block by the (ramping) gain
+    void process(const juce::dsp::AudioBlock<SampleType>& block);
+
+    // Kernel table for float ramps. Must outlive this stage
+    void setKernels(const DspKernels& newKernels) noexcept { kernels = &newKernels; }
+
+    // Linear gains for the next numSamples, for callers applying the gain themselves
+    const SampleType* getNextGains(int numSamples) { return gainSmoothed.getNextBlock(0, numSamples); }
+
+private:
+    BlockSmoother<SampleType, juce::ValueSmoothingTypes::Multiplicative> gainSmoothed{ 1 };
+
+    const DspKernels* kernels{ &DspKernels::forLevel(SimdLevel::generic) };
+
+    float targetDb{ 0.0f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GainStage)
+};
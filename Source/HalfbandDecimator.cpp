@@ -0,0 +1,123 @@
+#include "HalfbandDecimator.h"
+
+HalfbandDecimator::HalfbandDecimator(int numStages) : stages((size_t)juce::jmax(1, numStages))
+{
+    // For EACH STAGE: the last two get the longer filters, counted back from the end
+    for (size_t index = 0; index < stages.size(); ++index)
+    {
+        auto& stage = stages[index];
+        const size_t fromEnd = stages.size() - 1 - index;
+        stage.numTaps = fromEnd == 0 ? 23 : fromEnd == 1 ? 19 : 15;
+
+        // Blackman-windowed sinc with its cutoff at a quarter of the input rate. Even offsets from the centre
+        // are zero and the centre is 0.5, so only the odd offsets are kept
+        const int centreTap = stage.numTaps / 2;
+        const int numPairTaps = (centreTap + 1) / 2;
+        double pairSum = 0.0;
+
+        for (int pair = 0; pair < numPairTaps; ++pair)
+        {
+            const int offset = pair * 2 + 1;
+            const double x = juce::MathConstants<double>::pi * offset / 2.0;
+            const double phase = juce::MathConstants<double>::twoPi * (centreTap + offset) / (stage.numTaps - 1);
+            const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+
+            stage.pairCoefficients[(size_t)pair] = (float)(0.5 * std::sin(x) / x * window);
+            pairSum += stage.pairCoefficients[(size_t)pair];
+        }
+
+        // Unity gain at DC: the pairs have to add up to the other half
+        for (int pair = 0; pair < numPairTaps; ++pair)
+            stage.pairCoefficients[(size_t)pair] = (float)(stage.pairCoefficients[(size_t)pair] * 0.25 / pairSum);
+    }
+}
+
+void HalfbandDecimator::reset() noexcept
+{
+    for (auto& stage : stages)
+    {
+        stage.buffer.fill(0.0f);
+        stage.firstOutput = 0;
+    }
+}
+
+int HalfbandDecimator::process(const float* pairs, int numPairs, float* output) noexcept
+{
+    int numOutputs = 0;
+
+    // For EACH CHUNK:
+    for (int start = 0; start < numPairs; start += chunkSize)
+    {
+        // Every stage after the first filters the previous stage's output in place in scratch
+        int count = processStage(stages.front(), pairs + start * 2, juce::jmin(chunkSize, numPairs - start), scratch.data());
+
+        for (size_t stage = 1; stage < stages.size(); ++stage)
+            count = processStage(stages[stage], scratch.data(), count, scratch.data());
+
+        std::copy(scratch.begin(), scratch.begin() + count * 2, output + numOutputs * 2);
+        numOutputs += count;
+    }
+
+    return numOutputs;
+}
+
+int HalfbandDecimator::processStage(Stage& stage, const float* input, int numInputs, float* output) noexcept
+{
+    const int numTaps = stage.numTaps;
+    const int centreTap = numTaps / 2;
+    const int numPairTaps = (centreTap + 1) / 2;
+
+    float* buffer = stage.buffer.data();
+    std::copy(input, input + numInputs * 2, buffer + (numTaps - 1) * 2);
+
+    // Output pair n is centred on pair first + centreTap + 2n of the buffer, one every other input
+    const float* start = buffer + stage.firstOutput * 2;
+    const int numOutputs = (numInputs - stage.firstOutput + 1) / 2;
+
+    for (int n = 0; n < numOutputs; ++n)
+    {
+        output[n * 2] = 0.5f * start[(centreTap + n * 2) * 2];
+        output[n * 2 + 1] = 0.5f * start[(centreTap + n * 2) * 2 + 1];
+    }
+
+    // Every non-zero pair tap is an odd distance from the centre, so they all come from the other phase.
+    // Pulled out once, the taps of neighbouring outputs are contiguous for both signals and the loops below
+    // vectorise across them
+    float* otherPhase = otherPhaseScratch.data();
+    for (int i = 0; i < numOutputs + centreTap; ++i)
+    {
+        otherPhase[i * 2] = start[i * 4];
+        otherPhase[i * 2 + 1] = start[i * 4 + 1];
+    }
+
+    // The tap count is fixed per instantiation so the sums stay in registers
+    switch (numPairTaps)
+    {
+        case 4:  addPairTaps<4>(stage, otherPhase, numOutputs, output); break;
+        case 5:  addPairTaps<5>(stage, otherPhase, numOutputs, output); break;
+        default: addPairTaps<maxPairTaps>(stage, otherPhase, numOutputs, output); break;
+    }
+
+    stage.firstOutput = (stage.firstOutput + numInputs) & 1;    // Odd chunks shift the output phase
+
+    // Keep the newest numTaps - 1 pairs for the next chunk
+    std::copy(buffer + numInputs * 2, buffer + (numInputs + numTaps - 1) * 2, buffer);
+
+    return numOutputs;
+}
+
+template <int numPairTaps>
+void HalfbandDecimator::addPairTaps(const Stage& stage, const float* otherPhase, int numOutputs, float* output) noexcept
+{
+    const auto& coefficients = stage.pairCoefficients;
+
+    for (int i = 0; i < numOutputs * 2; ++i)
+    {
+        float sum = output[i];
+
+        for (int pair = 0; pair < numPairTaps; ++pair)
+            sum += coefficients[(size_t)pair] * (otherPhase[i + (numPairTaps - 1 - pair) * 2] + otherPhase[i + (numPairTaps + pair) * 2]);
+
+        output[i] = sum;
+    }
+}
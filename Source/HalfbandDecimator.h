@@ -0,0 +1,63 @@
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Cascade of halfband FIR stages, each low-passing and dropping every other
+    sample, for a total decimation of 2^numStages. Two signals go through
+    together as interleaved (first, second) pairs, so one pass filters both.
+
+    Each stage is a Blackman-windowed sinc halfband. Half its taps are zero and
+    the rest are symmetric, so an output costs one multiply per pair of taps
+    plus one for the centre tap, and only every other input makes one.
+    Everything up to half the final output's Nyquist must come through
+    alias-free, which leaves the early stages a much wider transition band
+    than the last one, so they get shorter filters:
+
+        last stage      23 taps, flat to 0.125 of its input rate, 75 dB down from 0.375
+        the one before  19 taps, flat to 0.0625, 81 dB down from 0.4375
+        earlier ones    15 taps, flat to 0.03125, 86 dB down from 0.46875
+
+    Latency is half a stage's taps, at the rate that stage runs at.
+*/
+class HalfbandDecimator
+{
+public:
+    explicit HalfbandDecimator(int numStages);
+
+    int getDecimationFactor() const noexcept { return 1 << (int)stages.size(); }
+
+    // Clear the filter history
+    void reset() noexcept;
+
+    // Filter numPairs interleaved pairs and write the decimated pairs to output. Returns how many pairs were
+    // written, at most numPairs / factor + 1. No allocation
+    int process(const float* pairs, int numPairs, float* output) noexcept;
+
+private:
+    static constexpr int maxTaps = 23;
+    static constexpr int maxPairTaps = (maxTaps / 2 + 1) / 2;  // Non-zero taps either side of the centre
+
+    static constexpr int chunkSize = 256;                   // Pairs filtered per pass through the stages
+
+    struct Stage
+    {
+        int numTaps = maxTaps;
+        std::array<float, maxPairTaps> pairCoefficients{};         // For offsets 1, 3, 5 ... from the centre
+        std::array<float, (maxTaps - 1 + chunkSize) * 2> buffer{}; // Last numTaps - 1 pairs, then the new chunk
+        int firstOutput = 0;                                        // 0 or 1, where in the chunk the next output falls
+    };
+
+    // Filter numInputs pairs through one stage, writing one pair per two. Returns the output count
+    int processStage(Stage& stage, const float* input, int numInputs, float* output) noexcept;
+
+    // Add a stage's pair taps, taken from its other phase, to numOutputs pairs that hold the centre tap
+    template <int numPairTaps>
+    static void addPairTaps(const Stage& stage, const float* otherPhase, int numOutputs, float* output) noexcept;
+
+    std::vector<Stage> stages;
+    std::array<float, chunkSize * 2> scratch{};
+    std::array<float, chunkSize + maxTaps * 2> otherPhaseScratch{};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(HalfbandDecimator)
+};
@@ -0,0 +1,27 @@
+#include "InterleavedDelayLine.h"
+
+#if JUCE_USE_SIMD
+
+template <typename SampleType>
+void InterleavedDelayLine<SampleType>::prepare(int newNumChannels, int minimumCapacity)
+{
+    jassert(newNumChannels <= maxChannels);
+
+    numChannels = newNumChannels;
+    const int capacity = juce::nextPowerOfTwo(juce::jmax(2, minimumCapacity));
+    mask = capacity - 1;
+    writePosition = 0;
+
+    frames.assign((size_t)capacity, Frame::expand((SampleType)0));
+}
+
+template <typename SampleType>
+void InterleavedDelayLine<SampleType>::clear()
+{
+    std::fill(frames.begin(), frames.end(), Frame::expand((SampleType)0));
+}
+
+template class InterleavedDelayLine<float>;
+template class InterleavedDelayLine<double>;
+
+#endif
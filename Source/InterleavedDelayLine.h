@@ -0,0 +1,48 @@
+#pragma once
+#include <JuceHeader.h>
+
+#if JUCE_USE_SIMD
+
+//==============================================================================
+/**
+    Delay ring with every channel of a frame packed into one SIMDRegister.
+
+    Holds up to SIMDRegister<SampleType>::size() channels (lanes): four floats or
+    two doubles on SSE/NEON. A tap read is one aligned register load, so
+    interpolation and feedback run once per frame for all channels.
+    Capacity is a power of two, index with (position & getMask()).
+*/
+template <typename SampleType>
+class InterleavedDelayLine
+{
+public:
+    using Frame = juce::dsp::SIMDRegister<SampleType>;
+
+    static constexpr int maxChannels = (int)Frame::SIMDNumElements;
+
+    InterleavedDelayLine() = default;
+
+    // Allocate and clear. Capacity becomes the next power of two >= minimumCapacity
+    void prepare(int numChannels, int minimumCapacity);
+
+    void clear();
+
+    int getNumChannels() const noexcept   { return numChannels; }
+    int getMask() const noexcept          { return mask; }
+    int getWritePosition() const noexcept { return writePosition; }
+
+    Frame* getFrames() noexcept { return frames.data(); }
+
+    // Move the write position on by numSamples. Call once per block
+    void advance(int numSamples) noexcept { writePosition = (writePosition + numSamples) & mask; }
+
+private:
+    std::vector<Frame> frames;
+    int numChannels{ 0 };
+    int mask{ 0 };
+    int writePosition{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(InterleavedDelayLine)
+};
+
+#endif
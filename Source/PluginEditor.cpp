@@ -219,7 +219,7 @@ SimpleGainSliderAudioProcessorEditor::SimpleGainSliderAudioProcessorEditor (Simp
 	// === Spectrum Analyser properties ===
 	contentSpectrum.setColour(juce::GroupComponent::outlineColourId, juce::Colours::transparentBlack);
 	contentSpectrum.addAndMakeVisible(spectrumAnalyser);
-	spectrumAnalyser.setTooltip("Visualizes the frequency spectrum of the audio signal after all effects are applied.");
+	spectrumAnalyser.setTooltip("Visualizes the frequency spectrum of the audio signal after all effects are applied (green), over the unprocessed input (blue). Right-click to pick the channel or mid/side source, change the FFT size, overlap and octave smoothing, switch to multi-resolution for finer low-end detail, or show the output as a scrolling spectrogram.");
 
     setSize(800, 400);
 }
@@ -20,18 +20,9 @@ SimpleGainSliderAudioProcessor::SimpleGainSliderAudioProcessor():
 
     // Initialisation list:
 
-    treeState(*this, nullptr, "PARAMETERS", createParameterLayout()),  // Construct treeState with parameter list
-
-	forwardFFT(fftOrder),   // Init forwardFFT with size of window
-  
-	window(fftSize, juce::dsp::WindowingFunction<float>::hann) // Init window as Hann 
+    treeState(*this, nullptr, "PARAMETERS", createParameterLayout())  // Construct treeState with parameter list
 
 {  // Processor construtor code:
-    
-    fftMagnitudesDb.resize(fftSize / 2);  // Set size of fftMagnitudesDb
-    std::fill(fftMagnitudesDb.begin(), fftMagnitudesDb.end(), minDb); // Set entire fftMagnitudesDb to dB floor
-    fifo.fill(0.0f);
-	fftData.fill(0.0f);
 
 	// Cast parameter pointers to their types
     attackParamPtr = dynamic_cast<juce::AudioParameterFloat*>(treeState.getParameter(ATTACK_ID)); 
@@ -50,6 +41,7 @@ SimpleGainSliderAudioProcessor::SimpleGainSliderAudioProcessor():
     treeState.addParameterListener(THRESHOLD_ID, this);
     treeState.addParameterListener(RATIO_ID, this);
 
+    setSimdLevel(DspKernels::getDefaultLevel()); // CPU check happens once, here
 }
 
 // Destructor
@@ -59,6 +51,8 @@ SimpleGainSliderAudioProcessor::~SimpleGainSliderAudioProcessor()
     treeState.removeParameterListener(RELEASE_ID, this);
     treeState.removeParameterListener(THRESHOLD_ID, this);
     treeState.removeParameterListener(RATIO_ID, this);
+
+    jassert(numAnalyserAttachments == 0); // The editor should have detached before the processor goes
 }
 
 //==============================================================================
@@ -126,36 +120,115 @@ void SimpleGainSliderAudioProcessor::changeProgramName (int index, const juce::S
 
 void SimpleGainSliderAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)  // In case  of change in sample rate or buffer size
 {
-    auto delayBufferSize = sampleRate * 2.5; // Delay buffer is 2.5 seconds of sample time
-    delayBuffer.setSize(getNumOutputChannels(), (int)delayBufferSize);
-	delayBuffer.clear();
+    // Everything below processBlock works a tile at a time, whatever the host block size
+    juce::ignoreUnused(samplesPerBlock);
 
-	inGainValueSmoothed.reset(sampleRate, 0.05f);
-	outGainValueSmoothed.reset(sampleRate, 0.05f);
+    // Only the chain matching the host's precision gets memory
+    if (isUsingDoublePrecision())
+        prepareChain(doubleChain, sampleRate);
+    else
+        prepareChain(floatChain, sampleRate);
 
-    delayTimeSmoothedChannels[0].reset(sampleRate, 0.2f);
-	delayTimeSmoothedChannels[1].reset(sampleRate, 0.2f);
-	delayFeedbackSmoothed.reset(sampleRate, 0.05f);
+    const juce::ScopedLock sl(analyserLock);
+    isPrepared = true;
 
-    // Compressor
+    if (spectrumAnalyser != nullptr && numAnalyserAttachmentsShowing > 0)
+        spectrumAnalyser->prepare(); // Start the FFT thread
+}
 
-	juce::dsp::ProcessSpec spec;
-	spec.maximumBlockSize = samplesPerBlock; 
-	spec.sampleRate = sampleRate;
-	spec.numChannels = getTotalNumOutputChannels();
-	compressor.prepare(spec); 
-    compressor.reset();
-    compressor.setAttack(attackParamPtr->get());
-    compressor.setRelease(releaseParamPtr->get());
-    compressor.setThreshold(thresholdParamPtr->get());
-    compressor.setRatio(ratioParamPtr->getCurrentChoiceName().getFloatValue());
+// Snap chain to the current parameters and allocate it
+template <typename SampleType>
+void SimpleGainSliderAudioProcessor::prepareChain(EffectChain<SampleType>& chain, double sampleRate)
+{
+    chain.setParameters(inGainParamPtr->get(), outGainParamPtr->get(), delayTimeParamPtr->get(), delayFeedbackParamPtr->get() / 100);
+    chain.prepare(sampleRate, getTotalNumOutputChannels(), processingTileSize);
 
+    chain.setCompressorAttack(attackParamPtr->get());
+    chain.setCompressorRelease(releaseParamPtr->get());
+    chain.setCompressorThreshold(thresholdParamPtr->get());
+    chain.setCompressorRatio(ratioParamPtr->getCurrentChoiceName().getFloatValue());
 }
 
 void SimpleGainSliderAudioProcessor::releaseResources()
 {
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
+    const juce::ScopedLock sl(analyserLock);
+    isPrepared = false;
+
+    if (spectrumAnalyser != nullptr)
+        spectrumAnalyser->release(); // No samples arrive until the next prepareToPlay
+}
+
+SpectrumAnalyser& SimpleGainSliderAudioProcessor::attachSpectrumAnalyser()
+{
+    const juce::ScopedLock sl(analyserLock);
+
+    if (numAnalyserAttachments++ == 0)
+    {
+        // Plans, windows and the ring are all allocated here, never on the audio thread
+        spectrumAnalyser = std::make_unique<SpectrumAnalyser>();
+        spectrumAnalyser->setKernels(*dspKernels);
+
+        if (savedAnalyserSettings)
+            spectrumAnalyser->setSettings(*savedAnalyserSettings);
+
+        // Nothing runs until an attachment is showing
+    }
+
+    return *spectrumAnalyser;
+}
+
+void SimpleGainSliderAudioProcessor::detachSpectrumAnalyser()
+{
+    const juce::ScopedLock sl(analyserLock);
+    jassert(numAnalyserAttachments > 0);
+
+    if (--numAnalyserAttachments > 0)
+        return;
+
+    jassert(numAnalyserAttachmentsShowing == 0); // Each attachment should have stopped showing first
+    stopSpectrumAnalyser();
+
+    savedAnalyserSettings = spectrumAnalyser->getSettings();
+    spectrumAnalyser.reset();
+}
+
+void SimpleGainSliderAudioProcessor::setSpectrumAnalyserShowing(bool isShowing)
+{
+    const juce::ScopedLock sl(analyserLock);
+    jassert(spectrumAnalyser != nullptr);
+
+    if (isShowing)
+    {
+        if (numAnalyserAttachmentsShowing++ == 0)
+            startSpectrumAnalyser();
+    }
+    else
+    {
+        jassert(numAnalyserAttachmentsShowing > 0);
+
+        if (--numAnalyserAttachmentsShowing == 0)
+            stopSpectrumAnalyser();
+    }
+}
+
+void SimpleGainSliderAudioProcessor::startSpectrumAnalyser()
+{
+    // The ring starts empty, so nothing from before the pause is analysed
+    if (isPrepared)
+        spectrumAnalyser->prepare();
+
+    activeAnalyser.store(spectrumAnalyser.get()); // Tapped from the next block
+}
+
+void SimpleGainSliderAudioProcessor::stopSpectrumAnalyser()
+{
+    // Once the pointer is cleared, a block that raised the flag while it still held it is the only user left.
+    // Later blocks see null and leave the flag down, so this waits out at most that one block
+    activeAnalyser.store(nullptr);
+    while (analyserInUse.load())
+        juce::Thread::yield();
+
+    spectrumAnalyser->release(); // Stops the FFT thread
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -165,12 +238,9 @@ bool SimpleGainSliderAudioProcessor::isBusesLayoutSupported (const BusesLayout&
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // Any layout is supported (mono, stereo, 5.1, 7.1.4, ambisonics...), as long as it isn't disabled.
+    // Per-channel state is sized from the channel count in prepareToPlay.
+    if (layouts.getMainOutputChannelSet().isDisabled())
         return false;
 
     // This checks if the input layout matches the output layout
@@ -187,12 +257,23 @@ bool SimpleGainSliderAudioProcessor::isBusesLayoutSupported (const BusesLayout&
 // __________________________________PROCESS BLOCK__________________________________________________________________________
 
 void SimpleGainSliderAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processBlockInternal(buffer, floatChain);
+}
+
+void SimpleGainSliderAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processBlockInternal(buffer, doubleChain);
+}
+
+// Shared float/double implementation
+template <typename SampleType>
+void SimpleGainSliderAudioProcessor::processBlockInternal(juce::AudioBuffer<SampleType>& buffer, EffectChain<SampleType>& chain)
 {
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
     auto bufferSize = buffer.getNumSamples();
-    auto delayBufferSize = delayBuffer.getNumSamples();
 
 	auto delayFeedbackParameter = delayFeedbackParamPtr->get(); 
 	auto delayTimeParameter = delayTimeParamPtr->get(); 
@@ -202,235 +283,116 @@ void SimpleGainSliderAudioProcessor::processBlock (juce::AudioBuffer<float>& buf
     // Clear junk data in output channels
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i) {     
         buffer.clear(i, 0, bufferSize);
-        delayBuffer.clear(i, 0, delayBufferSize);
+        chain.clearDelayChannel(i);
     }
 	
 	// Set targets for smoothed values
-    inGainValueSmoothed.setTargetValue(inGainSliderParameter);
-	outGainValueSmoothed.setTargetValue(outGainSliderParameter);
+    chain.setParameters(inGainSliderParameter, outGainSliderParameter, delayTimeParameter, delayFeedbackParameter / 100);
 
-	delayFeedbackSmoothed.setTargetValue(delayFeedbackParameter / 100); 
-	delayTimeSmoothedChannels[0].setTargetValue(delayTimeParameter); 
-    delayTimeSmoothedChannels[1].setTargetValue(delayTimeParameter);
+    // Channels the chain was prepared for; per-channel state is never allocated here
+    const int numChannels = juce::jmin(totalNumInputChannels, chain.getNumChannels(), buffer.getNumChannels());
+    auto block = juce::dsp::AudioBlock<SampleType>(buffer).getSubsetChannelBlock(0, (size_t)numChannels);
 
+    // No editor, no tap. The analyser is held for the whole block so a detach can't free it halfway. The flag only
+    // goes up for a non-null pointer, so once a detach has cleared it no later block keeps the detach waiting.
+    // The second load catches a detach that cleared it between the first load and the flag going up
+    auto* analyser = activeAnalyser.load();
 
-    // === INGAIN AND DELAY PROCESSING ===
-  
-    // For EACH CHANNEL:
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+    if (analyser != nullptr)
     {
-        auto* channelData = buffer.getWritePointer(channel);
-        auto* delayData = delayBuffer.getWritePointer(channel);
+        analyserInUse.store(true);
+        analyser = activeAnalyser.load();
 
-        // For EACH SAMPLE:
-        for (int sample = 0; sample < bufferSize; ++sample) { 	
-
-            // IN Gain processing
-            channelData[sample] = buffer.getSample(channel, sample) * (pow(10, inGainValueSmoothed.getNextValue() / 20));     // Multiply sample by gain volume
-			
-			int sampleWritePosition = (writePosition + sample) % delayBufferSize;   // Get writepos for sample for this loop's sample
-			float delayTime = delayTimeSmoothedChannels[channel].getNextValue();    // Get delay time 
-
-			// No delay operation, write to delay buffer
-            if (delayTime <= 0) {
-                delayData[sampleWritePosition] = channelData[sample];
-                continue;
-            }
-
-			// Get main read position
-            double readPos = (writePosition + sample) - (delayTime * getSampleRate());
-            if (readPos < 0) readPos += delayBufferSize;
-
-            // Get positions for interpolation
-            int readPosInt = static_cast<int>(readPos);
-            int nextReadPos = (readPosInt + 1) % delayBufferSize;
-            int nextnextReadPos = (readPosInt + 2) % delayBufferSize;
-            int prevReadPos = (readPosInt - 1 + delayBufferSize) % delayBufferSize;
-
-            float frac = readPos - readPosInt; // Fraction from readPos to nextReadPos
-
-            // Cubic interpolate
-            float delayedSample = cubicHermiteInterpolate(delayData[prevReadPos], delayData[readPosInt], delayData[nextReadPos], delayData[nextnextReadPos], frac);
-
-            // Write dry + delayedSample to delay buffer
-            delayData[sampleWritePosition] = channelData[sample] + (delayedSample * delayFeedbackSmoothed.getNextValue());
-
-            // Mix delayedSample into output
-            channelData[sample] += delayedSample;
-		}
+        if (analyser == nullptr)
+            analyserInUse.store(false);
     }
-    updateDelayBufferWritePosition(bufferSize); // Increment delay line writePos by amount of buffer copied to delayBuffer
 
-    // === COMPRESSOR PROCESSING === 
+    // Pick the kernel once per block, so the tile loop has no branch on the analysis tap
+    if (analyser != nullptr && numChannels > 0)
+        processTiles<SampleType, true>(block, chain, analyser);
+    else
+        processTiles<SampleType, false>(block, chain, nullptr);
 
-    auto block = juce::dsp::AudioBlock<float>(buffer);
-    auto context = juce::dsp::ProcessContextReplacing<float>(block); // Create process context
-    compressor.process(context);
+    if (analyser != nullptr)
+        analyserInUse.store(false);
+}
 
+// Run the whole chain one cache-sized tile at a time, so each stage reads data the previous one left in L1
+template <typename SampleType, bool WithAnalysisTap>
+void SimpleGainSliderAudioProcessor::processTiles(const juce::dsp::AudioBlock<SampleType>& block, EffectChain<SampleType>& chain, SpectrumAnalyser* analyser)
+{
+    const int bufferSize = (int)block.getNumSamples();
+    const auto analysisSource = WithAnalysisTap ? analyser->getSource() : SpectrumAnalyser::Source::left;   // Same mix for the whole block
+    std::array<SampleType, processingTileSize> analysisInput;   // The tile's analysed signal before the chain runs
+    std::array<SampleType, processingTileSize> analysisOutput;  // And after
 
+    for (int tileStart = 0; tileStart < bufferSize; tileStart += processingTileSize)
+    {
+        const int tileSize = juce::jmin(processingTileSize, bufferSize - tileStart);
+        auto tile = block.getSubBlock((size_t)tileStart, (size_t)tileSize);
 
-	// === OUTGAIN AND FIFO PROCESSING ===
+        // The chain works in place, so the input tap has to be taken first
+        if constexpr (WithAnalysisTap)
+            SpectrumAnalyser::mixSource(analysisSource, tile, analysisInput.data());
 
-    // For EACH CHANNEL:
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
-    {
-        auto* channelData = buffer.getWritePointer(channel);
-
-        // For EACH SAMPLE:
-        for (int sample = 0; sample < bufferSize; ++sample) {
-
-			// OUT Gain processing
-            channelData[sample] = buffer.getSample(channel, sample) * (pow(10, outGainValueSmoothed.getNextValue() / 20));     // Multiply by gain volume
-			
-            // FFT start process
-            if (channel == 0)
-            {
-                pushNextSampleIntoFifo(channelData[sample]);
-            }
-            
+        chain.processTile(tile); // In gain -> delay -> compressor -> out gain
+
+        // FFT start process - one mixed signal per tap. Input and output go into the analysis ring together, the FFT runs on its own thread
+        if constexpr (WithAnalysisTap)
+        {
+            SpectrumAnalyser::mixSource(analysisSource, tile, analysisOutput.data());
+            analyser->pushSamples(analysisInput.data(), analysisOutput.data(), tileSize);
         }
     }
-} 
+}
 // ____________________________________________END PROCESS BLOCK_________________________________________________________________
 
 void SimpleGainSliderAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
 {
+    // Compressor settings go to both chains so a precision switch keeps them
     if (parameterID == ATTACK_ID)
     {
         if (attackParamPtr)
-            compressor.setAttack(attackParamPtr->get() * 100);
-		
-        
+        {
+            floatChain.setCompressorAttack(attackParamPtr->get() * 100);
+            doubleChain.setCompressorAttack(attackParamPtr->get() * 100);
+        }
     }
     else if (parameterID == RELEASE_ID)
     {
         if (releaseParamPtr)
-            compressor.setRelease(releaseParamPtr->get());
-
+        {
+            floatChain.setCompressorRelease(releaseParamPtr->get());
+            doubleChain.setCompressorRelease(releaseParamPtr->get());
+        }
     }
     else if (parameterID == THRESHOLD_ID)
     {
         if (thresholdParamPtr)
-            compressor.setThreshold(thresholdParamPtr->get());
-
+        {
+            floatChain.setCompressorThreshold(thresholdParamPtr->get());
+            doubleChain.setCompressorThreshold(thresholdParamPtr->get());
+        }
     }
     else if (parameterID == RATIO_ID)
     {
         if (ratioParamPtr)
-            compressor.setRatio(ratioParamPtr->getCurrentChoiceName().getFloatValue());
-    }
-}
-
-// Puts sample into FIFO. If full, calls performFFTProcessing()
-void SimpleGainSliderAudioProcessor::pushNextSampleIntoFifo(float sample)
-{
-    if (fifoIndex == fftSize)  // Fifo is full
-    {
-         
-		if (!isNextFFTBlockReady()) // If UI has consumed the last block
-		{
-            performFFTProcessing();
-		}
-        fifoIndex = 0;
-    }
-
-    fifo[fifoIndex] = sample;  // Add sample to FIFO at index
-
-    // Increment index
-    fifoIndex++;
-}
-
-// Perform FFT processing on FIFO. Prepares fftMagnitudesDb for UI
-void SimpleGainSliderAudioProcessor::performFFTProcessing() {
-
-    // Apply windowing
-	window.multiplyWithWindowingTable(fifo.data(), fftSize); // Apply window to FIFO
-
-	// Copy windowed FIFO data into fftData
-    std::fill(fftData.begin(), fftData.end(), 0.0f);    
-    std::copy(fifo.begin(), fifo.end(), fftData.begin()); 
-
-	// Perform FFT on fftData
-	forwardFFT.performRealOnlyForwardTransform(fftData.data());
-
-	auto numFreqBins = fftSize / 2; 
-	std::vector<float> unlockedFftMagnitudesDb(numFreqBins);  // Hold FftMagnitudesDb before locking
-
-    // Calc normalisation factor
-
-    const float normalizationFactor = (float)fftSize / 4.0f;    // Average energy accross fft window, compensating for Hann Window power reduction. 
-    const float normalizationFactorSquared = normalizationFactor * normalizationFactor; // Square for dB conversion
-
-    // Get magnitudes and convert to dB
-	// For EACH FREQ BIN:
-    for (int freqBin = 0; freqBin < numFreqBins; ++freqBin)
-    {
-        float real = fftData[freqBin * 2];
-        float imag = fftData[freqBin * 2 + 1];
-        float magSquared = real * real + imag * imag;  // Get magnitude^2 of current freq bin
-		float normalisedMagSquared = magSquared / normalizationFactorSquared; // Normalise magnitude^2
-        
-		//  Convert to dB
-        float dBValue;
-        if (magSquared > 1e-10f) {
-            dBValue = 10.0f * std::log10(normalisedMagSquared);
-        }
-        else {
-            dBValue = minDb; // set to minDb if too small
+        {
+            floatChain.setCompressorRatio(ratioParamPtr->getCurrentChoiceName().getFloatValue());
+            doubleChain.setCompressorRatio(ratioParamPtr->getCurrentChoiceName().getFloatValue());
         }
-
-		unlockedFftMagnitudesDb[freqBin] = std::max(dBValue, minDb); // Store dB value
     }
-
-	// Copy magnitudes to fftMagnitudesDb
-	{
-        const juce::ScopedLock lock(scopeLock); // Lock during copy
-        std::copy(unlockedFftMagnitudesDb.begin(), unlockedFftMagnitudesDb.end(), fftMagnitudesDb.begin());
-	}
-
-    nextFFTBlockReady.store(true); // New data is ready for UI
-
-}
-
-// fftSize get function
-int SimpleGainSliderAudioProcessor::getFftSize() const { return fftSize; }
-
-// Increment delay buffer write position by buffersize
-void SimpleGainSliderAudioProcessor::updateDelayBufferWritePosition(int bufferSize) {
-	int delayBufferSize = delayBuffer.getNumSamples();
-    writePosition += bufferSize; // Increment writePosition
-	writePosition %= delayBufferSize; // Wrap around
 }
 
-// Cubic Hermite Interpolation function
-float SimpleGainSliderAudioProcessor::cubicHermiteInterpolate(float y0, float y1, float y2, float y3, float fractionalPosition) // Interpolate between y1 and y2
-{   
-    // Audio optimised formula based off of: https://github.com/kmatheussen/radium/blob/master/audio/SampleInterpolator.cpp
-    // Written by Kjetil Matheussen
-    
-    // Calculates a windowed cubic spline interpolation, using custom coefficients instead of Hermite basis functions.
-
-	// Half-weight the outer points to reduce pull of distant samples
-    float half_y0 = 0.5f * y0;
-    float half_y3 = 0.5f * y3;
-
-    // Get tangeant at y1
-    float slope_y1_to_y2 = (0.5f * y2) - half_y0;
-
-    // Calculate the curvature components
-	float curvature_term1 = (y0 + (2.0f * y2)) - (half_y3 + (2.5f * y1));       // Dampens y1
-	float curvature_term2 = (half_y3 + (1.5f * y1)) - ((1.5f * y2) + half_y0); // Flatten curve at y2 to prevent overshoot 
-
-    // Combine all components using Horner's method for efficiency
-    float interpolatedValue = y1 + fractionalPosition * (
-        slope_y1_to_y2 + fractionalPosition * (
-            curvature_term1 + fractionalPosition * (
-                curvature_term2
-                )
-            )
-        );
+void SimpleGainSliderAudioProcessor::setSimdLevel(SimdLevel newLevel)
+{
+    dspKernels = &DspKernels::forLevel(newLevel);
+    floatChain.setKernels(*dspKernels);
+    doubleChain.setKernels(*dspKernels);
 
-    return interpolatedValue;
+    const juce::ScopedLock sl(analyserLock);
+    if (spectrumAnalyser != nullptr)
+        spectrumAnalyser->setKernels(*dspKernels);
 }
 
 // Parameter layout
@@ -474,62 +436,6 @@ juce::AudioProcessorValueTreeState::ParameterLayout SimpleGainSliderAudioProcess
 
 }
 
-// Deprecated - Read from delay buffer and add to buffer
-void SimpleGainSliderAudioProcessor::readFromDelayBuffer(juce::AudioBuffer<float>& buffer, int channel)
-{
-    auto bufferSize = buffer.getNumSamples();
-    auto delayBufferSize = delayBuffer.getNumSamples();
-
-    auto delayGain = (treeState.getRawParameterValue(DELAY_FEEDBACK_ID)->load()); //get delay gain parameter
-    auto delayTime = (treeState.getRawParameterValue(DELAY_TIME_ID)->load());
-
-    auto readPosition = writePosition - (delayTime * getSampleRate());   // set readPos relative to writePos in delayBuffer
-    if (readPosition < 0) {
-        readPosition += delayBufferSize; // if readPosition is negative, wrap around
-    }
-
-    // Adding bufferSize portion of delayBuffer to buffer
-    if (readPosition + bufferSize < delayBufferSize)    // If bufferSized portion of delayBuffer has no loop
-    {
-        buffer.addFromWithRamp(channel, 0, delayBuffer.getReadPointer(channel, readPosition), bufferSize, delayGain, delayGain);
-    }
-    else {
-        // bufferSized portion of delayBuffer has loop
-        auto numSamplesToEnd = delayBufferSize - readPosition;
-        buffer.addFromWithRamp(channel, 0, delayBuffer.getReadPointer(channel, readPosition), numSamplesToEnd, delayGain, delayGain);
-
-        auto numSamplesAtStart = bufferSize - numSamplesToEnd;
-        buffer.addFromWithRamp(channel, numSamplesToEnd, delayBuffer.getReadPointer(channel, 0), numSamplesAtStart, delayGain, delayGain);
-    }
-}
-
-// Deprecated - Copy main buffer into delay buffer
-void SimpleGainSliderAudioProcessor::fillBuffer(juce::AudioBuffer<float>& buffer, int channel) {
-
-    auto bufferSize = buffer.getNumSamples();
-    auto delayBufferSize = delayBuffer.getNumSamples();
-
-    //check if main buffer copies to delay buffer without wrapping
-    if (delayBufferSize >= writePosition + bufferSize) {
-
-        //copy main buffer to delay buffer
-        delayBuffer.copyFrom(channel, writePosition, buffer.getWritePointer(channel), bufferSize);
-    }
-    //if wrapping
-    else
-    {
-        auto numSamplesToEnd = delayBufferSize - writePosition;      // space remaining until end of delay buffer
-        delayBuffer.copyFrom(channel, writePosition, buffer.getWritePointer(channel), numSamplesToEnd);
-
-        auto numSamplesAtStart = bufferSize - numSamplesToEnd;         // Calc the remaining content amount
-        delayBuffer.copyFrom(channel, 0, buffer.getWritePointer(channel, numSamplesToEnd), numSamplesAtStart);
-    }
-
-    /* DBG("Delay buffer size: " << delayBufferSize);
-     DBG("Buffer size: " << bufferSize);
-     DBG("Write position: " << writePosition);*/
-}
-
 //==============================================================================
 bool SimpleGainSliderAudioProcessor::hasEditor() const
 {
@@ -1,6 +1,8 @@
 #pragma once
 #include <JuceHeader.h>
 #include <juce_dsp/juce_dsp.h>
+#include "EffectChain.h"
+#include "SpectrumAnalyser.h"
 
 #define INGAIN_ID "inGain"
 #define INGAIN_NAME "Input Gain"
@@ -72,6 +74,8 @@ public:
    #endif
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -96,8 +100,6 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
-    int getFftSize() const;
-
     juce::AudioProcessorValueTreeState treeState; // Declare processor's APVTS
     
     static const juce::StringArray getRatioChoices() {
@@ -105,25 +107,21 @@ public:
         return choices;
     }
 
-    // Get FFT results
-    std::vector<float> SimpleGainSliderAudioProcessor::getLatestMagnitudesDb() const
-    {
-        const juce::ScopedLock lock(scopeLock); // Lock during read
-        return fftMagnitudesDb; // Return a copy of the member variable
-    }
+    // Message thread. Creates the analyser on the first attach; the last detach frees it, keeping its settings
+    // for next time. Each attach needs one detach
+    SpectrumAnalyser& attachSpectrumAnalyser();
+    void detachSpectrumAnalyser();
 
-    bool isNextFFTBlockReady() const noexcept
-    {
-        return nextFFTBlockReady.load();
-    }
-
-    void resetNextFFTBlockReady() noexcept
-    {
-        nextFFTBlockReady.store(false);
-    }
+    // Message thread, between attach and detach. The audio is only tapped and analysed while at least one
+    // attachment is on screen, so a hidden or minimised editor costs neither thread anything
+    void setSpectrumAnalyserShowing(bool isShowing);
 
     void parameterChanged(const juce::String& parameterID, float newValue) override;
 
+    // Force the instruction set of the DSP kernels (clamped to what the CPU supports). Call while not processing
+    void setSimdLevel(SimdLevel newLevel);
+    SimdLevel getSimdLevel() const noexcept { return dspKernels->level; }
+
 private:
 	// == Parameters ==
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
@@ -139,49 +137,36 @@ private:
 	juce::AudioParameterFloat* delayFeedbackParamPtr{ nullptr };    // Delay
 	juce::AudioParameterFloat* delayTimeParamPtr{ nullptr };
 
-	// === Gain ===
-    juce::LinearSmoothedValue<float> inGainValueSmoothed{ 0.0f };
-    juce::LinearSmoothedValue<float> outGainValueSmoothed{ 0.0f };
-
-	// === Delay ===
-	juce::LinearSmoothedValue<float> delayFeedbackSmoothed{ 0.0f };
-    std::array<juce::LinearSmoothedValue<float>, 2> delayTimeSmoothedChannels;
-    juce::AudioBuffer<float> delayBuffer;
-    int writePosition{ 0 };
-    
-	// == Compressor ===
-
-	juce::dsp::Compressor<float> compressor;
-
-
-
-    //=== Fast Fourier Transform === 
-    juce::dsp::FFT forwardFFT;
-    juce::dsp::WindowingFunction<float> window;
-
-
+	// === Effect chain, one per processing precision ===
+    EffectChain<float> floatChain;
+    EffectChain<double> doubleChain;
+    const DspKernels* dspKernels{ nullptr };    // Picked once in the constructor
 
-	std::vector<float> fftMagnitudesDb; // Stores magnitudes of FFT data in dB
-    juce::CriticalSection scopeLock;               // Protects fftMagnitudesDb access
 
-	static constexpr int fftOrder = 11;     // Size of the FFT window
-	static constexpr int fftSize = 1 << fftOrder; // Calculate the size of the FFT - 2^11
-    const float minDb = -100.0f;
-    std::atomic<bool> nextFFTBlockReady{ false };        // Whether next FFT block is ready for processing     
 
-	std::array<float, fftSize> fifo;        // Contains incoming samples FIFO
-    int fifoIndex = 0;                     // Count of samples in FIFO
+    //=== Fast Fourier Transform ===
+    // Only exists while an editor is open, only runs while one is on screen. Audio thread only pushes samples, FFT runs on the analyser's thread
+    std::unique_ptr<SpectrumAnalyser> spectrumAnalyser;
+    std::atomic<SpectrumAnalyser*> activeAnalyser{ nullptr };  // What the audio thread taps, null for no tap
+    std::atomic<bool> analyserInUse{ false };                   // Set by the audio thread while it holds a non-null activeAnalyser
+    juce::CriticalSection analyserLock;         // Attach and detach against prepare and release. Never taken by the audio thread
+    int numAnalyserAttachments = 0;
+    int numAnalyserAttachmentsShowing = 0;      // The analyser runs while this is above zero
+    bool isPrepared = false;                    // Between prepareToPlay and releaseResources
+    std::optional<SpectrumAnalyser::Settings> savedAnalyserSettings;    // From the last detach
 
-	std::array<float, fftSize * 2> fftData; // Stores results of FFT
+    // Start the analysis thread and the tap, or stop both. Called with analyserLock held
+    void startSpectrumAnalyser();
+    void stopSpectrumAnalyser();
 
-    float cubicHermiteInterpolate(float y0, float y1, float y2, float y3, float fractionalPosition);
-    void pushNextSampleIntoFifo(float sample);
-    void performFFTProcessing();
-    void updateDelayBufferWritePosition(int bufferSize);
+    static constexpr int processingTileSize = 64; // Frames per pass of the fused effect chain
 
-    // ==== Legacy buffer functions ====
-    void fillBuffer(juce::AudioBuffer<float>& buffer, int channel);
-    void readFromDelayBuffer(juce::AudioBuffer<float>& buffer, int channel);
+    template <typename SampleType>
+    void prepareChain(EffectChain<SampleType>& chain, double sampleRate);
+    template <typename SampleType>
+    void processBlockInternal(juce::AudioBuffer<SampleType>& buffer, EffectChain<SampleType>& chain);
+    template <typename SampleType, bool WithAnalysisTap>
+    void processTiles(const juce::dsp::AudioBlock<SampleType>& block, EffectChain<SampleType>& chain, SpectrumAnalyser* analyser);
     
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleGainSliderAudioProcessor)
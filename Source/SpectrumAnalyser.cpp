@@ -0,0 +1,412 @@
+#include "SpectrumAnalyser.h"
+
+SpectrumAnalyser::SpectrumAnalyser() : juce::Thread("Spectrum analyser")
+{
+    ring.assign((size_t)ringSize * 2, 0.0f);
+    frame.assign((size_t)maxFftSize * 2, 0.0f);
+    windowed.assign((size_t)maxFftSize * 2, 0.0f);
+    fftData.assign((size_t)maxFftSize * 2, 0.0f);
+    inputBins.assign((size_t)maxFftSize + 2, 0.0f);
+
+    // Every window size up front, so changing order never allocates. Only the first analyser in the process
+    // builds them
+    for (int order = minFftOrder; order <= maxFftOrder; ++order)
+        windows[(size_t)(order - minFftOrder)] = planCache->getWindow(juce::dsp::WindowingFunction<float>::hann, order);
+
+    // The other backends wait until they are selected
+    {
+        const juce::ScopedLock sl(planLock);
+        createPlans(fftBackend.load());
+    }
+
+    binsDb.assign((size_t)maxNumFreqBins, minDb);
+    powerSums.assign((size_t)maxNumFreqBins + 1, 0.0);
+
+    // === Multi-resolution ===
+
+    decimated.assign((size_t)2 << shortFftOrder, 0.0f);     // A read never takes more than one short frame
+    longFrame.assign((size_t)2 << longFftOrder, 0.0f);
+    longPointsDb.fill(minDb);
+    longInputPointsDb.fill(minDb);
+
+    updateLogPoints();
+
+    Spectrum silence;
+    silence.magnitudesDb.fill(minDb); // Every slot starts at the dB floor
+    silence.inputMagnitudesDb.fill(minDb);
+    snapshots.fill(silence);
+}
+
+SpectrumAnalyser::~SpectrumAnalyser()
+{
+    release();
+}
+
+void SpectrumAnalyser::prepare()
+{
+    release(); // Ring and frame are only reset while the consumer is stopped
+
+    fifo.reset();
+    frameIndex = 0;
+    resetLongBand();
+
+    startThread();
+}
+
+void SpectrumAnalyser::release()
+{
+    stopThread(1000);
+}
+
+// Poll the ring and run an FFT every time a frame fills
+void SpectrumAnalyser::run()
+{
+    while (!threadShouldExit())
+    {
+        analysePending();
+        wait(pollIntervalMs);
+    }
+}
+
+void SpectrumAnalyser::analysePending()
+{
+    while (readIntoFrame())
+    {
+        // A short frame is skipped if the next one in the ring will replace it before the UI could show it,
+        // or if one was transformed less than shortFftInterval samples ago
+        const bool superseded = frameMultiResolution
+                             && (fifo.getNumReady() >= getFrameHopSize() || samplesSinceShortFft < shortFftInterval);
+
+        if (!superseded)
+        {
+            performFFTProcessing();
+            samplesSinceShortFft = 0;
+        }
+
+        advanceFrame();
+    }
+}
+
+bool SpectrumAnalyser::readIntoFrame()
+{
+    const bool newMultiResolution = multiResolution.load();
+    const int newOrder = newMultiResolution ? shortFftOrder : fftOrder.load();
+    const Smoothing newSmoothing = smoothing.load();
+
+    if (newOrder != frameOrder || newMultiResolution != frameMultiResolution || newSmoothing != frameSmoothing)
+    {
+        const int newSize = 1 << newOrder;
+
+        // Keep the newest samples that fit, so a size change doesn't leave a gap
+        if (frameIndex > newSize)
+        {
+            std::copy(frame.begin() + (frameIndex - newSize) * 2, frame.begin() + frameIndex * 2, frame.begin());
+            frameIndex = newSize;
+        }
+
+        if (newMultiResolution != frameMultiResolution)
+            resetLongBand();
+
+        frameOrder = newOrder;
+        frameMultiResolution = newMultiResolution;
+        frameSmoothing = newSmoothing;
+        updateLogPoints();
+    }
+
+    const int frameSize = 1 << frameOrder;
+    const auto scope = fifo.read(juce::jmin(fifo.getNumReady(), frameSize - frameIndex));
+    float* dest = frame.data() + frameIndex * 2;
+
+    std::copy(ring.data() + scope.startIndex1 * 2, ring.data() + (scope.startIndex1 + scope.blockSize1) * 2, dest);
+    std::copy(ring.data() + scope.startIndex2 * 2, ring.data() + (scope.startIndex2 + scope.blockSize2) * 2, dest + scope.blockSize1 * 2);
+
+    if (frameMultiResolution)
+        processLongFrame(dest, scope.blockSize1 + scope.blockSize2);
+
+    frameIndex += scope.blockSize1 + scope.blockSize2;
+
+    return frameIndex == frameSize;
+}
+
+void SpectrumAnalyser::advanceFrame()
+{
+    const int frameSize = 1 << frameOrder;
+    const int hop = getFrameHopSize();
+
+    std::copy(frame.begin() + hop * 2, frame.begin() + frameSize * 2, frame.begin());
+    frameIndex = frameSize - hop;
+
+    if (frameMultiResolution)
+        samplesSinceShortFft += hop;
+}
+
+int SpectrumAnalyser::getFrameHopSize() const noexcept
+{
+    return getHopSize(1 << frameOrder, frameMultiResolution ? Overlap::none : overlap.load());
+}
+
+void SpectrumAnalyser::setFftBackend(FftBackend::Type newType)
+{
+    // The plans are complete before the store, so the analysis thread never sees a type it can't run
+    const juce::ScopedLock sl(planLock);
+
+    createPlans(newType);
+    fftBackend.store(newType);
+}
+
+void SpectrumAnalyser::createPlans(FftBackend::Type type)
+{
+    // For EACH ORDER: table plans come from the shared cache, juce and simd ones are this instance's own
+    for (int order = minFftOrder; order <= maxFftOrder; ++order)
+    {
+        const auto index = (size_t)(order - minFftOrder);
+
+        switch (type)
+        {
+            case FftBackend::Type::table:
+                if (tableFFTs[index] == nullptr)
+                    tableFFTs[index] = &planCache->getTablePlan(order);
+                break;
+
+            case FftBackend::Type::simd:
+                if (simdFFTs[index] == nullptr)
+                    simdFFTs[index] = FftBackend::create(FftBackend::Type::simd, order);
+                break;
+
+            case FftBackend::Type::juce:
+                if (juceFFTs[index] == nullptr)
+                    juceFFTs[index] = FftBackend::create(FftBackend::Type::juce, order);
+                break;
+        }
+    }
+}
+
+SpectrumAnalyser::Settings SpectrumAnalyser::getSettings() const noexcept
+{
+    return { fftOrder.load(), overlap.load(), fftBackend.load(), multiResolution.load(), smoothing.load(), source.load() };
+}
+
+void SpectrumAnalyser::setSettings(const Settings& newSettings)
+{
+    setFftOrder(newSettings.fftOrder);
+    setOverlap(newSettings.overlap);
+    setFftBackend(newSettings.fftBackend);
+    setMultiResolution(newSettings.multiResolution);
+    setSmoothing(newSettings.smoothing);
+    setSource(newSettings.source);
+}
+
+int SpectrumAnalyser::getHopSize(int fftSize, Overlap frameOverlap) noexcept
+{
+    switch (frameOverlap)
+    {
+        case Overlap::quarter:       return fftSize - fftSize / 4;
+        case Overlap::half:          return fftSize / 2;
+        case Overlap::threeQuarters: return fftSize / 4;
+        case Overlap::none:          break;
+    }
+
+    return fftSize;
+}
+
+float SpectrumAnalyser::getPointFrequency(int point) noexcept
+{
+    constexpr float lowest = 1.0f / (float)((1 << longFftOrder) << numDecimationStages);     // The long FFT's first bin
+    return lowest * std::pow(0.5f / lowest, (float)point / (float)(numPoints - 1));
+}
+
+void SpectrumAnalyser::performFFTProcessing()
+{
+    // Written straight into the free snapshot slot
+    auto& spectrum = snapshots.getWriteBuffer();
+
+    transform(frame.data(), frameOrder);
+
+    // In multi-resolution mode the lows come from the last long frame
+    std::copy(longPointsDb.begin(), longPointsDb.begin() + numLongPoints, spectrum.magnitudesDb.begin());
+    std::copy(longInputPointsDb.begin(), longInputPointsDb.begin() + numLongPoints, spectrum.inputMagnitudesDb.begin());
+    rebinPoints(fftData.data(), frameOrder, numLongPoints, numPoints, spectrum.magnitudesDb.data());
+    rebinPoints(inputBins.data(), frameOrder, numLongPoints, numPoints, spectrum.inputMagnitudesDb.data());
+
+    spectrum.sequence = ++sequence;
+    snapshots.publish(); // New data is ready for UI
+}
+
+void SpectrumAnalyser::transform(const float* pairs, int order)
+{
+    const int fftSize = 1 << order;
+    const auto orderIndex = (size_t)(order - minFftOrder);
+    const float* window = windows[orderIndex];
+
+	// Copy frame into windowed and apply windowing. Both halves of a pair share the window value
+    for (int i = 0; i < fftSize; ++i)
+    {
+        windowed[(size_t)i * 2] = pairs[i * 2] * window[i];
+        windowed[(size_t)i * 2 + 1] = pairs[i * 2 + 1] * window[i];
+    }
+
+	// Perform FFT into fftData. setFftBackend built the type's plans before storing it
+    const FftBackend* forwardFFT = nullptr;
+
+    switch (fftBackend.load())
+    {
+        case FftBackend::Type::table: forwardFFT = tableFFTs[orderIndex]; break;
+        case FftBackend::Type::simd:  forwardFFT = simdFFTs[orderIndex].get(); break;
+        default:                      forwardFFT = juceFFTs[orderIndex].get(); break;
+    }
+
+	forwardFFT->performTwoRealForwardTransforms(windowed.data(), fftData.data(), inputBins.data());
+}
+
+void SpectrumAnalyser::rebinPoints(const float* bins, int order, int begin, int end, float* destDb)
+{
+    const int fftSize = 1 << order;
+    const int numFreqBins = fftSize / 2;
+
+    // Calc normalisation factor
+
+    const float normalizationFactor = (float)fftSize / 4.0f;    // Average energy accross fft window, compensating for Hann Window power reduction.
+    const float normalizationFactorSquared = normalizationFactor * normalizationFactor; // Square for dB conversion
+
+    if (frameSmoothing == Smoothing::none)
+    {
+        // Normalised magnitude^2 to dB, clamped at minDb, in one vectorised pass
+        kernels.load()->powerToDecibels(binsDb.data(), bins, 1.0f / normalizationFactorSquared, minDb, numFreqBins);
+
+        // For EACH POINT:
+        for (int point = begin; point < end; ++point)
+        {
+            const auto& logPoint = logPoints[(size_t)point];
+            const float* pointBinsDb = binsDb.data() + logPoint.firstBin;
+
+            if (logPoint.numBins > 0)
+                destDb[point] = *std::max_element(pointBinsDb, pointBinsDb + logPoint.numBins);
+            else
+                destDb[point] = pointBinsDb[0] + logPoint.fraction * (pointBinsDb[1] - pointBinsDb[0]);
+        }
+
+        return;
+    }
+
+    // Running totals in double: a quiet band high above loud bins would otherwise cancel to noise
+    double total = 0.0;
+    for (int bin = 0; bin < numFreqBins; ++bin)
+    {
+        powerSums[(size_t)bin] = total;
+
+        const float real = bins[bin * 2];
+        const float imag = bins[bin * 2 + 1];
+        total += (double)(((real * real) + (imag * imag)) / normalizationFactorSquared);
+    }
+    powerSums[(size_t)numFreqBins] = total;
+
+    // Total power below a fractional bin position, with each bin's power spread evenly across it
+    auto powerBelow = [this, numFreqBins](float position)
+    {
+        const int bin = juce::jlimit(0, numFreqBins - 1, (int)std::floor(position + 0.5f));
+        const double binPower = powerSums[(size_t)bin + 1] - powerSums[(size_t)bin];
+        return powerSums[(size_t)bin] + (double)(position + 0.5f - (float)bin) * binPower;
+    };
+
+    // For EACH POINT:
+    for (int point = begin; point < end; ++point)
+    {
+        const auto& logPoint = logPoints[(size_t)point];
+        pointPower[(size_t)point] = (float)((powerBelow(logPoint.high) - powerBelow(logPoint.low)) / (double)(logPoint.high - logPoint.low));
+    }
+
+    kernels.load()->decibelsFromPower(destDb + begin, pointPower.data() + begin, minDb, end - begin);
+}
+
+void SpectrumAnalyser::updateLogPoints()
+{
+    const float pointRatio = getPointFrequency(1) / getPointFrequency(0);
+
+    // Points reach halfway (in log frequency) to their neighbours, or half the smoothing width either side
+    float halfWidth = std::sqrt(pointRatio);
+    switch (frameSmoothing)
+    {
+        case Smoothing::thirdOctave:   halfWidth = std::exp2(1.0f / 6.0f);  break;
+        case Smoothing::sixthOctave:   halfWidth = std::exp2(1.0f / 12.0f); break;
+        case Smoothing::twelfthOctave: halfWidth = std::exp2(1.0f / 24.0f); break;
+        case Smoothing::none:          break;
+    }
+
+    numLongPoints = 0;
+
+    // For EACH POINT:
+    for (int point = 0; point < numPoints; ++point)
+    {
+        const float frequency = getPointFrequency(point);
+        auto& logPoint = logPoints[(size_t)point];
+
+        logPoint = LogPoint();
+        logPoint.fromLongFft = frameMultiResolution && frequency < crossoverFrequency;
+
+        const int order = logPoint.fromLongFft ? longFftOrder : frameOrder;
+        const float binsPerCycle = (float)((1 << order) << (logPoint.fromLongFft ? numDecimationStages : 0));
+        const int numBandBins = (1 << order) / 2;
+
+        if (logPoint.fromLongFft)
+            ++numLongPoints;
+
+        if (frameSmoothing != Smoothing::none)
+        {
+            const float edge = (float)numBandBins - 0.5f;
+            logPoint.high = juce::jlimit(-0.5f, edge, frequency * halfWidth * binsPerCycle);
+            logPoint.low = juce::jlimit(-0.5f, logPoint.high - 0.01f, frequency / halfWidth * binsPerCycle);
+            continue;
+        }
+
+        // Whole bins between the midpoints to the neighbouring points
+        const int firstBin = (int)std::ceil(frequency / halfWidth * binsPerCycle);
+        const int endBin = juce::jmin((int)std::ceil(frequency * halfWidth * binsPerCycle), numBandBins);
+
+        if (endBin > firstBin)
+        {
+            logPoint.firstBin = firstBin;
+            logPoint.numBins = endBin - firstBin;
+        }
+        else
+        {
+            const float position = frequency * binsPerCycle;
+            logPoint.firstBin = juce::jmin((int)position, numBandBins - 2);
+            logPoint.fraction = position - (float)logPoint.firstBin;
+        }
+    }
+}
+
+void SpectrumAnalyser::resetLongBand()
+{
+    samplesSinceShortFft = shortFftInterval; // The first short frame goes straight out
+    decimator.reset();
+    longFrameIndex = 0;
+    longPointsDb.fill(minDb);     // Lows stay at the floor until the first long frame
+    longInputPointsDb.fill(minDb);
+}
+
+void SpectrumAnalyser::processLongFrame(const float* pairs, int numPairs)
+{
+    const int longSize = 1 << longFftOrder;
+
+    // Both signals are decimated together, still as (output, input) pairs
+    const int numDecimated = decimator.process(pairs, numPairs, decimated.data());
+
+    for (int i = 0; i < numDecimated;)
+    {
+        const int numToCopy = juce::jmin(numDecimated - i, longSize - longFrameIndex);
+        std::copy(decimated.begin() + i * 2, decimated.begin() + (i + numToCopy) * 2, longFrame.begin() + longFrameIndex * 2);
+
+        longFrameIndex += numToCopy;
+        i += numToCopy;
+
+        if (longFrameIndex == longSize)
+        {
+            transform(longFrame.data(), longFftOrder);
+            rebinPoints(fftData.data(), longFftOrder, 0, numLongPoints, longPointsDb.data());
+            rebinPoints(inputBins.data(), longFftOrder, 0, numLongPoints, longInputPointsDb.data());
+
+            longFrameIndex = 0; // No overlap: the lows change slowly and this keeps the mode within budget
+        }
+    }
+}
@@ -0,0 +1,331 @@
+#pragma once
+#include <JuceHeader.h>
+#include "DspKernels.h"
+#include "TripleBuffer.h"
+#include "FftBackend.h"
+#include "FftPlanCache.h"
+#include "HalfbandDecimator.h"
+
+//==============================================================================
+/**
+    FFT analysis of the plugin's input and processed output, run on its own
+    thread.
+
+    The audio thread only calls pushSamples(), which copies into a wait-free
+    single-producer/single-consumer ring (juce::AbstractFifo) and never blocks.
+    If the ring is full the samples are dropped, the analysis just sees a gap.
+    The two signals are stored interleaved as (output, input) pairs all the
+    way to the FFT, where each frame goes in as output + i * input: one
+    complex FFT gives both spectra. Each is one stream whatever the channel
+    count: mixSource() folds the channels down to the chosen source (left,
+    right, sum, mid, side or max) on the audio thread before the push.
+    A background thread polls the ring and runs an overlapping STFT on it:
+    windowing, FFT and dB conversion, so none of that touches processBlock.
+    FFT size (order 9-14) and overlap can change at any time. Windows for
+    every order are set up in the constructor, so changing order allocates
+    nothing. An FFT backend's plans, every order at once, are built the first
+    time it is selected, on the selecting thread and before the analysis
+    thread can see the new type. Only the default backend is built up front.
+    Windows and table-backend plans come from the process-wide FftPlanCache:
+    only the first analyser in the process builds them. juce and simd plans
+    keep working state in the object, so each instance builds its own,
+    alongside its ring, frames and scratch.
+    Each frame is rebinned to numPoints log-spaced points before it is
+    published, so the UI gets the same small curve whatever the FFT size.
+    Without smoothing a point takes the peak of the bins it spans. With 1/3,
+    1/6 or 1/12-octave smoothing it takes the mean power over that band, read
+    from running power totals, so the cost doesn't grow with the band width.
+    Every frame is published through a TripleBuffer; the UI reads the latest
+    one in place without locks, copies or allocation.
+
+    In multi-resolution mode the FFT size and overlap settings are ignored. A
+    512-point FFT runs on the full-rate signal for the highs. A 1024-point FFT
+    runs on a copy decimated by 8 for the lows, giving 8192-point resolution
+    there. Each short frame is stitched with the latest long one, crossing
+    over at 1/32 of the sample rate (1.5 kHz at 48 kHz). The mode must cost no
+    more than one non-overlapped 2048-point FFT, so neither band overlaps and
+    only the newest short frame per 1024 samples is transformed: about 47
+    frames a second at 48 kHz, twice the rate of the 2048-point setting.
+*/
+class SpectrumAnalyser : private juce::Thread
+{
+public:
+    static constexpr int minFftOrder = 9;        // 512 points
+    static constexpr int maxFftOrder = 14;       // 16384 points
+    static constexpr int defaultFftOrder = 11;
+    static constexpr int maxFftSize = 1 << maxFftOrder;
+    static constexpr int maxNumFreqBins = maxFftSize / 2;
+    static constexpr float minDb = -100.0f;
+    static constexpr int numPoints = 256;        // Log-spaced points per published spectrum
+
+    // Fraction of each frame shared with the next one
+    enum class Overlap
+    {
+        none,
+        quarter,        // 25%
+        half,           // 50%
+        threeQuarters   // 75%
+    };
+
+    // Which signal is analysed, from the first two channels (mono blocks use channel 0 for both)
+    enum class Source
+    {
+        left,
+        right,
+        sum,    // L + R
+        mid,    // (L + R) / 2
+        side,   // (L - R) / 2
+        max     // Per sample, whichever channel is furthest from zero. Covers every channel
+    };
+
+    // Frequency smoothing, in fractions of an octave
+    enum class Smoothing
+    {
+        none,
+        thirdOctave,
+        sixthOctave,
+        twelfthOctave
+    };
+
+    // Everything the settings menu changes, to carry over to the next analyser
+    struct Settings
+    {
+        int fftOrder;
+        Overlap overlap;
+        FftBackend::Type fftBackend;
+        bool multiResolution;
+        Smoothing smoothing;
+        Source source;
+    };
+
+    // One analysed frame
+    struct Spectrum
+    {
+        juce::uint32 sequence = 0;                          // Goes up by one per frame, 0 until the first
+        std::array<float, numPoints> magnitudesDb{};        // Output. Point i sits at getPointFrequency(i)
+        std::array<float, numPoints> inputMagnitudesDb{};   // Input, before the in-gain stage, on the same points
+    };
+
+    SpectrumAnalyser();
+    ~SpectrumAnalyser() override;
+
+    // Clear the ring and start the analysis thread. Call from prepareToPlay
+    void prepare();
+
+    // Stop the analysis thread. Call from releaseResources
+    void release();
+
+    // Any thread. Used from the next frame on
+    void setFftOrder(int newOrder) noexcept  { fftOrder.store(juce::jlimit(minFftOrder, maxFftOrder, newOrder)); }
+    void setOverlap(Overlap newOverlap) noexcept { overlap.store(newOverlap); }
+    void setMultiResolution(bool shouldBeOn) noexcept { multiResolution.store(shouldBeOn); }
+    void setSmoothing(Smoothing newSmoothing) noexcept { smoothing.store(newSmoothing); }
+    void setSource(Source newSource) noexcept { source.store(newSource); }
+    int getFftOrder() const noexcept         { return fftOrder.load(); }
+    Overlap getOverlap() const noexcept      { return overlap.load(); }
+    FftBackend::Type getFftBackend() const noexcept { return fftBackend.load(); }
+    bool isMultiResolution() const noexcept  { return multiResolution.load(); }
+    Smoothing getSmoothing() const noexcept  { return smoothing.load(); }
+    Source getSource() const noexcept        { return source.load(); }
+
+    // Message thread, or any thread but the audio and analysis threads. Builds the backend's plans the first
+    // time it is selected, so it may allocate
+    void setFftBackend(FftBackend::Type newType);
+
+    Settings getSettings() const noexcept;
+    void setSettings(const Settings& newSettings);     // Calls setFftBackend
+
+    // Samples between frame starts
+    static int getHopSize(int fftSize, Overlap frameOverlap) noexcept;
+
+    // Frequency of a point in cycles per sample (Hz / sample rate). Log-spaced from 1/8192 up to Nyquist
+    static float getPointFrequency(int point) noexcept;
+
+    // Kernel table for the power spectrum. Safe to call while the thread runs
+    void setKernels(const DspKernels& newKernels) noexcept { kernels.store(&newKernels); }
+
+    // Audio thread. Fold block's channels down to one signal for sourceToMix, in whole-block vector passes
+    template <typename SampleType>
+    static void mixSource(Source sourceToMix, const juce::dsp::AudioBlock<SampleType>& block, SampleType* dest) noexcept
+    {
+        using FVO = juce::FloatVectorOperations;
+
+        const int numSamples = (int)block.getNumSamples();
+        const int numChannels = (int)block.getNumChannels();
+        const SampleType* left = block.getChannelPointer(0);
+        const SampleType* right = block.getChannelPointer(numChannels > 1 ? 1u : 0u);
+
+        switch (sourceToMix)
+        {
+            case Source::left:  FVO::copy(dest, left, numSamples); break;
+            case Source::right: FVO::copy(dest, right, numSamples); break;
+            case Source::sum:   FVO::add(dest, left, right, numSamples); break;
+
+            case Source::mid:
+                FVO::add(dest, left, right, numSamples);
+                FVO::multiply(dest, (SampleType)0.5, numSamples);
+                break;
+
+            case Source::side:
+                FVO::subtract(dest, left, right, numSamples);
+                FVO::multiply(dest, (SampleType)0.5, numSamples);
+                break;
+
+            case Source::max:
+                FVO::copy(dest, left, numSamples);
+
+                // For EACH OTHER CHANNEL: keep the sample further from zero, sign included
+                for (int channel = 1; channel < numChannels; ++channel)
+                {
+                    const SampleType* samples = block.getChannelPointer((size_t)channel);
+
+                    for (int i = 0; i < numSamples; ++i)
+                        dest[i] = std::abs(samples[i]) > std::abs(dest[i]) ? samples[i] : dest[i];
+                }
+                break;
+        }
+    }
+
+    // Audio thread. Copies the matching input and output samples into the ring, dropping what doesn't fit
+    template <typename SampleType>
+    void pushSamples(const SampleType* input, const SampleType* output, int numSamples) noexcept
+    {
+        const auto scope = fifo.write(juce::jmin(numSamples, fifo.getFreeSpace()));
+
+        copyToRing(scope.startIndex1, input, output, scope.blockSize1);
+        copyToRing(scope.startIndex2, input + scope.blockSize1, output + scope.blockSize1, scope.blockSize2);
+    }
+
+    // Analyse every frame the ring has filled. The analysis thread calls this each poll.
+    // Without prepare(), there is no thread and a caller (e.g. a benchmark) can drive it directly
+    void analysePending();
+
+    // UI thread only. The newest frame, valid until the next call. Compare sequence to see if it changed
+    const Spectrum& getLatestSpectrum() noexcept
+    {
+        snapshots.acquireLatest();
+        return snapshots.getReadBuffer();
+    }
+
+private:
+    void run() override;
+
+    // Move what the ring holds into the frame. True once the frame is full
+    bool readIntoFrame();
+    void performFFTProcessing();
+
+    // Keep the overlapping part of the frame for the next one
+    void advanceFrame();
+
+    // Samples between frames for the frame being collected. Multi-resolution ignores the overlap setting
+    int getFrameHopSize() const noexcept;
+
+    // Window and FFT 2^order (output, input) pairs. The output's bins go to fftData and the input's to inputBins
+    void transform(const float* pairs, int order);
+
+    // Fill destDb[begin..end) from the bins of a transform of this order
+    void rebinPoints(const float* bins, int order, int begin, int end, float* destDb);
+
+    // Build whichever of a backend's plans don't exist yet. Called with planLock held
+    void createPlans(FftBackend::Type type);
+
+    // Work out the bins behind each point for the frame's order, mode and smoothing
+    void updateLogPoints();
+
+    // === Multi-resolution ===
+
+    // Clear the decimator and the long frame, and drop the lows to the floor
+    void resetLongBand();
+
+    // Decimate newly read pairs into the long frame, running its FFT each time it fills
+    void processLongFrame(const float* pairs, int numPairs);
+
+    template <typename SampleType>
+    void copyToRing(int start, const SampleType* input, const SampleType* output, int numSamples) noexcept
+    {
+        float* dest = ring.data() + start * 2;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            dest[i * 2] = (float)output[i];
+            dest[i * 2 + 1] = (float)input[i];
+        }
+    }
+
+    static constexpr int numFftOrders = maxFftOrder - minFftOrder + 1;
+    static constexpr int ringSize = 1 << 15;        // Room for several polls at 192 kHz if the thread falls behind
+    static constexpr int pollIntervalMs = 10;
+
+    static constexpr int shortFftOrder = 9;                 // Highs: 512 points at the full rate
+    static constexpr int longFftOrder = 10;                 // Lows: 1024 points after decimation
+    static constexpr int numDecimationStages = 3;           // Decimate by 8
+    static constexpr float crossoverFrequency = 1.0f / 32.0f;     // Top of the decimator's alias-free band
+    static constexpr int shortFftInterval = 2 << shortFftOrder;   // Fewest samples between short FFTs
+
+    // Bins behind one published point
+    struct LogPoint
+    {
+        bool fromLongFft = false;   // Multi-resolution only, for points below the crossover
+
+        // Smoothed: mean power from low to high, in bins (bin k spans k - 0.5 to k + 0.5)
+        float low = 0.0f;
+        float high = 0.0f;
+
+        // Unsmoothed: peak of numBins bins from firstBin, or interpolated if the point is narrower than a bin
+        int firstBin = 0;
+        int numBins = 0;            // 0 to interpolate between firstBin and firstBin + 1
+        float fraction = 0.0f;
+    };
+
+    // === Audio -> analysis thread ===
+    juce::AbstractFifo fifo{ ringSize };        // Counts (output, input) pairs
+    std::vector<float> ring;                    // ringSize pairs
+
+    // === Settings, any thread -> analysis thread ===
+    std::atomic<int> fftOrder{ defaultFftOrder };
+    std::atomic<Overlap> overlap{ Overlap::half };
+    std::atomic<FftBackend::Type> fftBackend{ FftBackend::getDefaultType() };
+    std::atomic<bool> multiResolution{ false };
+    std::atomic<Smoothing> smoothing{ Smoothing::none };
+    std::atomic<Source> source{ Source::left };     // Read by the audio thread, once per block
+
+    // === Plans, written by setFftBackend before it stores the type, then only read ===
+    juce::CriticalSection planLock;             // Serialises setFftBackend calls
+    juce::SharedResourcePointer<FftPlanCache> planCache;    // Keeps the shared plans and windows alive
+    std::array<std::unique_ptr<FftBackend>, numFftOrders> juceFFTs;    // One plan per order, this instance's own
+    std::array<std::unique_ptr<FftBackend>, numFftOrders> simdFFTs;    // Likewise
+    std::array<const FftBackend*, numFftOrders> tableFFTs{};           // One plan per order, from planCache
+
+    // === Analysis thread only ===
+    std::array<const float*, numFftOrders> windows{};           // Hann window per order, from planCache
+    int frameOrder = defaultFftOrder;           // Order of the frame being collected
+    std::vector<float> frame;                   // (output, input) pairs collected for the next FFT
+    int frameIndex = 0;                         // Count of pairs in frame
+    std::vector<float> windowed;                // Windowed pairs, the FFT's input
+    std::vector<float> fftData;                 // Stores results of FFT, the output's bins after a transform
+    std::vector<float> inputBins;               // The input's bins after a transform
+    juce::uint32 sequence = 0;
+
+    bool frameMultiResolution = false;          // Mode of the frame being collected
+    int samplesSinceShortFft = shortFftInterval;    // Multi-resolution only, counted in hops
+    Smoothing frameSmoothing = Smoothing::none;
+    std::array<LogPoint, numPoints> logPoints;  // For frameOrder, frameMultiResolution and frameSmoothing
+    std::vector<float> binsDb;                  // dB per bin, for peak rebinning
+    std::vector<double> powerSums;              // powerSums[k] is the total power of the bins below k
+    std::array<float, numPoints> pointPower{};  // Smoothed power per point, before dB conversion
+
+    HalfbandDecimator decimator{ numDecimationStages };         // Both signals, as pairs
+    std::vector<float> decimated;               // Decimated pairs from one read of the ring
+    std::vector<float> longFrame;               // Decimated pairs for the next long FFT
+    int longFrameIndex = 0;
+    int numLongPoints = 0;                      // Points from the long FFT. They come first
+    std::array<float, numPoints> longPointsDb{};    // Only redone when the long FFT runs
+    std::array<float, numPoints> longInputPointsDb{};
+
+    std::atomic<const DspKernels*> kernels{ &DspKernels::forLevel(SimdLevel::generic) };
+
+    // === Analysis thread -> UI ===
+    TripleBuffer<Spectrum> snapshots;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SpectrumAnalyser)
+};
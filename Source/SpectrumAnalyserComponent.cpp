@@ -2,51 +2,314 @@
 
 // Use your actual processor class name here
 SpectrumAnalyserComponent::SpectrumAnalyserComponent(SimpleGainSliderAudioProcessor& p) :
-    audioProcessor(p)
+    audioProcessor(p),
+    analyser(p.attachSpectrumAnalyser())
 {
-    const auto numFreqBins = audioProcessor.getFftSize() / 2;
+	fftSmoothedData.resize(SpectrumAnalyser::numPoints); // Same log points whatever the FFT size
+    inputSmoothedData.resize(SpectrumAnalyser::numPoints);
 
-    fftDisplayData.resize(numFreqBins);
+    std::fill(fftSmoothedData.begin(), fftSmoothedData.end(), minDb);  // Fill display data with min db
+    std::fill(inputSmoothedData.begin(), inputSmoothedData.end(), minDb);
+    repaintedData = fftSmoothedData;
+    repaintedInputData = inputSmoothedData;
+    columns.reserve(SpectrumAnalyser::numPoints);   // Rebuilt in place from then on
 
-	fftSmoothedData.resize(numFreqBins);
+    // Spectrogram colours: black through blue, magenta and orange to yellow as the level rises
+    juce::ColourGradient heatMap(juce::Colours::black, 0.0f, 0.0f, juce::Colours::yellow, 1.0f, 0.0f, false);
+    heatMap.addColour(0.3, juce::Colours::darkblue);
+    heatMap.addColour(0.55, juce::Colours::darkmagenta);
+    heatMap.addColour(0.8, juce::Colours::orange);
 
-	std::fill(fftDisplayData.begin(), fftDisplayData.end(), minDb);  // Fill display data with min db
+    // For EACH COLOUR:
+    for (size_t i = 0; i < spectrogramColours.size(); ++i)
+        spectrogramColours[i] = heatMap.getColourAtPosition((double)i / (double)(spectrogramColours.size() - 1)).getPixelARGB();
 
-    std::fill(fftSmoothedData.begin(), fftSmoothedData.end(), minDb);
+    setOpaque(true); // The background image covers every pixel
 
-    startTimerHz(30);
+    // Updates and the analysis start once the component is on screen, see updateVBlankAttachment()
 }
 
 SpectrumAnalyserComponent::~SpectrumAnalyserComponent()
 {
+    vBlankAttachment = {};
     stopTimer();
+
+    if (analyserShowing)
+        audioProcessor.setSpectrumAnalyserShowing(false);
+
+    audioProcessor.detachSpectrumAnalyser(); // Frees the analyser
+}
+
+void SpectrumAnalyserComponent::visibilityChanged()
+{
+    updateVBlankAttachment();
+}
+
+void SpectrumAnalyserComponent::parentHierarchyChanged()
+{
+    updateVBlankAttachment(); // Also covers being added to or removed from a window
+}
+
+void SpectrumAnalyserComponent::handleAsyncUpdate()
+{
+    updateVBlankAttachment();
 }
 
 void SpectrumAnalyserComponent::timerCallback()
 {
-    if (audioProcessor.isNextFFTBlockReady())
+    if (isShowing())
+        updateVBlankAttachment(); // The window was restored
+}
+
+void SpectrumAnalyserComponent::updateVBlankAttachment()
+{
+    const bool showing = isShowing();
+
+    // Nothing is drawn while hidden, so the processor stops tapping the audio and the FFT thread
+    if (showing != analyserShowing)
+    {
+        analyserShowing = showing;
+        audioProcessor.setSpectrumAnalyserShowing(showing);
+    }
+
+    if (showing)
+    {
+        stopTimer();
+
+        if (vBlankAttachment.isEmpty())
+            vBlankAttachment = juce::VBlankAttachment(this, [this] { onVBlank(); });
+    }
+    else
+    {
+        vBlankAttachment = {};
+
+        // Still in a window, so possibly minimised: look a few times a second. Off screen entirely,
+        // parentHierarchyChanged() brings it back
+        if (getPeer() != nullptr)
+            startTimerHz(4);
+        else
+            stopTimer();
+    }
+}
+
+bool SpectrumAnalyserComponent::curvesMovedSinceRepaint() const
+{
+    // A quarter of a pixel in dB, at the current plot height
+    const float plotHeight = juce::jmax(1.0f, getLocalBounds().toFloat().reduced(10.0f).getHeight());
+    const float thresholdDb = 0.25f * (maxDb - minDb) / plotHeight;
+
+    // For EACH POINT:
+    for (size_t i = 0; i < fftSmoothedData.size(); ++i)
+    {
+        if (std::abs(fftSmoothedData[i] - repaintedData[i]) > thresholdDb
+            || std::abs(inputSmoothedData[i] - repaintedInputData[i]) > thresholdDb)
+            return true;
+    }
+
+    return false;
+}
+
+void SpectrumAnalyserComponent::onVBlank()
+{
+    // Minimising the window hides the component without a visibility callback, so check here
+    // and detach from outside the vblank callback. The timer re-attaches once the window is restored
+    if (!isShowing())
     {
-		fftDisplayData = audioProcessor.getLatestMagnitudesDb(); // Load FFT Db data
+        triggerAsyncUpdate();
+        return;
+    }
 
-		audioProcessor.resetNextFFTBlockReady();    // Allow next FFT block to process
+    const auto& spectrum = analyser.getLatestSpectrum(); // Read in place, no copy
+
+    if (spectrum.sequence != lastSequence)
+    {
+        lastSequence = spectrum.sequence;
 
         // Apply smoothing to new data
 
-        if (fftDisplayData.size() == fftSmoothedData.size())
+        // For EACH POINT:
+        for (size_t i = 0; i < fftSmoothedData.size(); ++i)
         {
-            // For EACH BIN:
-            for (size_t i = 0; i < fftSmoothedData.size(); ++i)
+			// Interpolate between smoothed and new data
+            fftSmoothedData[i] = (smoothingFactor * spectrum.magnitudesDb[i]) + ((1.0f - smoothingFactor) * fftSmoothedData[i]);
+            inputSmoothedData[i] = (smoothingFactor * spectrum.inputMagnitudesDb[i]) + ((1.0f - smoothingFactor) * inputSmoothedData[i]);
+        }
+
+        bool needsRepaint = curvesMovedSinceRepaint();
+
+        // The spectrogram shows each frame as it came, unsmoothed
+        if (displayMode == DisplayMode::spectrogram)
+        {
+            const double sampleRate = audioProcessor.getSampleRate();
+
+            if (spectrogramImage.isNull() || sampleRate != spectrogramSampleRate)
+                resetSpectrogram(sampleRate);
+
+            if (spectrogramImage.isValid())
             {
-				// Interpolate between smoothed and new data
-                fftSmoothedData[i] = (smoothingFactor * fftDisplayData[i]) + ((1.0f - smoothingFactor) * fftSmoothedData[i]);
+                writeSpectrogramColumn(spectrum.magnitudesDb);
+                needsRepaint = true; // Scrolls with every frame
             }
         }
-        repaint(); // Redraw UI
+
+        // Nothing to redraw once smoothing has settled, e.g. on silence
+        if (needsRepaint)
+        {
+            repaintedData = fftSmoothedData;
+            repaintedInputData = inputSmoothedData;
+            repaint(getLocalBounds().reduced(8)); // Plot and stroke width. The frequency labels below it never change
+        }
     }
 }
 
+void SpectrumAnalyserComponent::mouseDown(const juce::MouseEvent& event)
+{
+    if (event.mods.isPopupMenu())
+        showSettingsMenu();
+}
+
+// Right-click menu with the analysis settings
+void SpectrumAnalyserComponent::showSettingsMenu()
+{
+    auto& analyser = this->analyser; // The menu closes without calling back if this component goes first
+
+    juce::PopupMenu fftSizeMenu;
+    for (int order = SpectrumAnalyser::minFftOrder; order <= SpectrumAnalyser::maxFftOrder; ++order)
+        fftSizeMenu.addItem(juce::String(1 << order), !analyser.isMultiResolution(), analyser.getFftOrder() == order,
+                            [&analyser, order] { analyser.setFftOrder(order); });
+
+    juce::PopupMenu overlapMenu;
+    const std::pair<SpectrumAnalyser::Overlap, const char*> overlaps[] = {
+        { SpectrumAnalyser::Overlap::none, "0%" },
+        { SpectrumAnalyser::Overlap::quarter, "25%" },
+        { SpectrumAnalyser::Overlap::half, "50%" },
+        { SpectrumAnalyser::Overlap::threeQuarters, "75%" }
+    };
+    for (const auto& [overlap, name] : overlaps)
+        overlapMenu.addItem(name, !analyser.isMultiResolution(), analyser.getOverlap() == overlap,
+                            [&analyser, overlap = overlap] { analyser.setOverlap(overlap); });
+
+    juce::PopupMenu backendMenu;
+    for (auto type : { FftBackend::Type::juce, FftBackend::Type::table, FftBackend::Type::simd })
+        backendMenu.addItem(FftBackend::getTypeName(type), true, analyser.getFftBackend() == type,
+                            [&analyser, type] { analyser.setFftBackend(type); });
+
+    juce::PopupMenu smoothingMenu;
+    const std::pair<SpectrumAnalyser::Smoothing, const char*> smoothings[] = {
+        { SpectrumAnalyser::Smoothing::none, "None" },
+        { SpectrumAnalyser::Smoothing::thirdOctave, "1/3 Octave" },
+        { SpectrumAnalyser::Smoothing::sixthOctave, "1/6 Octave" },
+        { SpectrumAnalyser::Smoothing::twelfthOctave, "1/12 Octave" }
+    };
+    for (const auto& [smoothing, name] : smoothings)
+        smoothingMenu.addItem(name, true, analyser.getSmoothing() == smoothing,
+                              [&analyser, smoothing = smoothing] { analyser.setSmoothing(smoothing); });
+
+    juce::PopupMenu sourceMenu;
+    const std::pair<SpectrumAnalyser::Source, const char*> sources[] = {
+        { SpectrumAnalyser::Source::left, "Left" },
+        { SpectrumAnalyser::Source::right, "Right" },
+        { SpectrumAnalyser::Source::sum, "L+R" },
+        { SpectrumAnalyser::Source::mid, "Mid" },
+        { SpectrumAnalyser::Source::side, "Side" },
+        { SpectrumAnalyser::Source::max, "Max" }
+    };
+    for (const auto& [source, name] : sources)
+        sourceMenu.addItem(name, true, analyser.getSource() == source,
+                           [&analyser, source = source] { analyser.setSource(source); });
+
+    juce::PopupMenu menu;
+    menu.addSubMenu("Source", sourceMenu);
+    menu.addSubMenu("FFT Size", fftSizeMenu);
+    menu.addSubMenu("Overlap", overlapMenu);
+    menu.addSubMenu("Smoothing", smoothingMenu);
+    menu.addSubMenu("FFT Engine", backendMenu);
+    menu.addItem("Multi-resolution", true, analyser.isMultiResolution(),
+                 [&analyser] { analyser.setMultiResolution(!analyser.isMultiResolution()); });
+    menu.addSeparator();
+    menu.addItem("Spectrogram", true, displayMode == DisplayMode::spectrogram,
+                 [this] { setDisplayMode(displayMode == DisplayMode::spectrogram ? DisplayMode::spectrum : DisplayMode::spectrogram); });
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(this));
+}
+
 void SpectrumAnalyserComponent::paint(juce::Graphics& g)
 {
+    float sampleRate = audioProcessor.getSampleRate();
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+    // Grid, axes and labels only change with the size, the sample rate or the display scale
+    if (backgroundImage.isNull() || sampleRate != backgroundSampleRate || scale != backgroundScale)
+        renderBackground(sampleRate, scale);
+
+    g.drawImage(backgroundImage, getLocalBounds().toFloat());
+
+    // Spectrogram: the history as two blits, oldest columns first, whatever the number of columns
+    if (displayMode == DisplayMode::spectrogram)
+    {
+        if (spectrogramImage.isNull()) return;
+
+        const auto area = getSpectrogramArea();
+        const int numRows = spectrogramImage.getHeight();
+        const int olderWidth = spectrogramImage.getWidth() - spectrogramWriteX; // From the write position to the end
+
+        g.setImageResamplingQuality(juce::Graphics::lowResamplingQuality); // Stretch rows without blurring them
+
+        g.drawImage(spectrogramImage, area.getX(), area.getY(), olderWidth, area.getHeight(),
+                    spectrogramWriteX, 0, olderWidth, numRows);
+
+        if (spectrogramWriteX > 0)
+            g.drawImage(spectrogramImage, area.getX() + olderWidth, area.getY(), spectrogramWriteX, area.getHeight(),
+                        0, 0, spectrogramWriteX, numRows);
+        return;
+    }
+
+    const float maxFreq = (float)sampleRate / 2.0f;
+
+    // Error catching
+    if (sampleRate <= 0) return;
+	if (maxFreq <= minFreq) return; // Invalid freq range
+
+    // Bounds changes are picked up in resized(), but the sample rate can change under us
+    if (sampleRate != mappedSampleRate)
+        updatePointMapping(sampleRate);
+
+	// Draw paths, input under output
+
+	g.setColour(juce::Colours::lightblue.withAlpha(0.6f)); // Input path color
+	g.strokePath(createSpectrumPath(inputSmoothedData), juce::PathStrokeType(1.0f));
+
+	g.setColour(juce::Colours::green); // Output path color
+	g.strokePath(createSpectrumPath(fftSmoothedData), juce::PathStrokeType(1.5f)); // Stroke path with 1.5f width
+}
+
+// Frequencies to draw gridlines for, in both display modes
+static const std::vector<float> freqsToPlot = {
+    30.0f, 50.0f, 100.0f, 200.0f, 500.0f,
+    1000.0f, 2000.0f, 5000.0f, 10000.0f, 20000.0f
+};
+
+// Format frequency labels
+static juce::String formatFrequencyLabel(float freq)
+{
+    if (freq >= 1000.0f)
+        return juce::String(freq / 1000.0f, 1) + "k"; // Add "k" for kHz
+    else
+        return juce::String(static_cast<int>(freq));
+}
+
+// Draw everything but the curves into backgroundImage, at the display's pixel density
+void SpectrumAnalyserComponent::renderBackground(float sampleRate, float scale)
+{
+    backgroundSampleRate = sampleRate;
+    backgroundScale = scale;
+    backgroundImage = juce::Image(juce::Image::RGB,
+                                  juce::jmax(1, juce::roundToInt((float)getWidth() * scale)),
+                                  juce::jmax(1, juce::roundToInt((float)getHeight() * scale)),
+                                  false);
+
+    juce::Graphics g(backgroundImage);
+    g.addTransform(juce::AffineTransform::scale(scale)); // Draw in component coordinates
+
 	g.fillAll(juce::Colours::black); // Background colour
     
     // Component bounds
@@ -58,68 +321,31 @@ void SpectrumAnalyserComponent::paint(juce::Graphics& g)
     auto bottom = bounds.getBottom();
     auto right = bounds.getRight();
 
-	const auto& magnitudes = fftSmoothedData;
-    
-    auto fftSize = audioProcessor.getFftSize();
-	auto numFreqBins = magnitudes.size();
-    float sampleRate = audioProcessor.getSampleRate();
-    const float maxFreq = (float)sampleRate / 2.0f;
+    const float maxFreq = sampleRate / 2.0f;
 
     // Error catching
-	if (magnitudes.empty())	return; // No data to display
-    if (sampleRate <= 0 || fftSize <= 0) return;
+    if (sampleRate <= 0) return;
 	
     // Set dB and freq ranges
 
 	if (maxFreq <= minFreq) return; // Invalid freq range
 
-    const float logMinFreq = std::log(minFreq);
-    const float logFreqRange = std::log(maxFreq) - logMinFreq;
-
-    juce::Path spectrumPath;
-    bool pathStarted = false;
-
-    float freqBinWidth = (float)sampleRate / (float)fftSize;
-
-    // For EACH FFT BIN :
-    for (size_t fftBin = 1; fftBin < numFreqBins; ++fftBin)
+    if (displayMode == DisplayMode::spectrogram)
     {
-		
-        // Get X position of current bin
-        float currentBinFreq = freqBinWidth * (float)fftBin;
-
-        // Error catching
-		if (currentBinFreq < minFreq) continue;  // Skip out of range bins
-		if (currentBinFreq > maxFreq) break; 
-		
-        float logFreq = std::log(currentBinFreq);
-        float normalisedX = juce::jmap(logFreq, logMinFreq, logMinFreq + logFreqRange, 0.0f, 1.0f); // Map frequency logarithmically to  0.0 - 1.0
-		float x = left + (width * normalisedX); 
-
-		// Get Y position of current bin
-
-        float currentBinDb = magnitudes[fftBin];
-		float normalisedY = juce::jmap(currentBinDb, minDb, maxDb, 0.0f, 1.0f); // Map dB to 0.0 - 1.0
-  
-        float y = bottom - height * juce::jlimit(0.0f, 1.0f, normalisedY); // Clamp normY
-
-        // Process Path
-
-		if (!pathStarted)
-		{
-			spectrumPath.startNewSubPath(x, y); // Start path at x,y
-			pathStarted = true;
-		}
-		else
-		{
-			spectrumPath.lineTo(x, y); // Path to x,y
-		}
+        drawSpectrogramLabels(g, sampleRate);
+        return;
     }
 
-	// Draw path
+    const float logMinFreq = std::log(minFreq);
+    const float logFreqRange = std::log(maxFreq) - logMinFreq;
+
+	// Legend
 
-	g.setColour(juce::Colours::green); // Path color
-	g.strokePath(spectrumPath, juce::PathStrokeType(1.5f)); // Stroke path with 2.0f width
+	g.setFont(juce::Font(11.0f));
+	g.setColour(juce::Colours::lightblue.withAlpha(0.6f));
+	g.drawText("In", juce::roundToInt(right - 70), juce::roundToInt(top), 30, 14, juce::Justification::centredRight);
+	g.setColour(juce::Colours::green);
+	g.drawText("Out", juce::roundToInt(right - 35), juce::roundToInt(top), 30, 14, juce::Justification::centredRight);
 
 	// Draw axes
 
@@ -137,19 +363,6 @@ void SpectrumAnalyserComponent::paint(juce::Graphics& g)
 
     // Frequencies to draw gridlines for
 
-    std::vector<float> freqsToPlot = {
-        30.0f, 50.0f, 100.0f, 200.0f, 500.0f,
-        1000.0f, 2000.0f, 5000.0f, 10000.0f, 20000.0f
-    };
-
-    // Lambda func to format frequency labels
-    auto formatFrequencyLabel = [](float freq) -> juce::String {
-        if (freq >= 1000.0f)
-			return juce::String(freq / 1000.0f, 1) + "k"; // Add "k" for kHz
-        else
-            return juce::String(static_cast<int>(freq)); 
-        };
-
 	// For EACH FREQ:
     for (float freq : freqsToPlot)
     {
@@ -213,6 +426,171 @@ void SpectrumAnalyserComponent::paint(juce::Graphics& g)
 }
 
 
+// Time runs left to right and frequency bottom to top, on the same log points as the spectrum
+void SpectrumAnalyserComponent::drawSpectrogramLabels(juce::Graphics& g, float sampleRate) const
+{
+    const auto area = getSpectrogramArea().toFloat();
+    const int firstPoint = getSpectrogramFirstPoint(sampleRate);
+    const float rowHeight = area.getHeight() / (float)(SpectrumAnalyser::numPoints - firstPoint);
+
+    // Points are evenly spaced in log frequency, so a frequency's row follows from the first point and the spacing
+    const float logFirstFreq = std::log(sampleRate * SpectrumAnalyser::getPointFrequency(0));
+    const float logPointSpacing = std::log(SpectrumAnalyser::getPointFrequency(1) / SpectrumAnalyser::getPointFrequency(0));
+
+    juce::Font labelFont(10.0f);
+    g.setFont(labelFont);
+    g.setColour(juce::Colours::white.withAlpha(0.6f));
+
+    // For EACH FREQ:
+    for (float freq : freqsToPlot)
+    {
+        if (freq < minFreq || freq > sampleRate / 2.0f) continue;
+
+        const float point = (std::log(freq) - logFirstFreq) / logPointSpacing;
+        const float row = (float)(SpectrumAnalyser::numPoints - 1) - point; // Top row is Nyquist
+        const float y = area.getY() + (row + 0.5f) * rowHeight;
+
+        g.drawHorizontalLine(juce::roundToInt(y), area.getX() - 4.0f, area.getX()); // Tick
+        g.drawText(formatFrequencyLabel(freq), juce::roundToInt(area.getX() - 34.0f), juce::roundToInt(y - labelFont.getHeight() / 2.0f),
+                   28, juce::roundToInt(labelFont.getHeight()), juce::Justification::centredRight, 1);
+    }
+}
+
+juce::Rectangle<int> SpectrumAnalyserComponent::getSpectrogramArea() const
+{
+    return getLocalBounds().reduced(10).withTrimmedLeft(30);
+}
+
+int SpectrumAnalyserComponent::getSpectrogramFirstPoint(double sampleRate) const
+{
+    int point = 0;
+
+    while (point < SpectrumAnalyser::numPoints - 1 && sampleRate * SpectrumAnalyser::getPointFrequency(point) < minFreq)
+        ++point;
+
+    return point;
+}
+
+void SpectrumAnalyserComponent::resetSpectrogram(double sampleRate)
+{
+    spectrogramSampleRate = sampleRate;
+    spectrogramWriteX = 0;
+    spectrogramImage = juce::Image();
+
+    const auto area = getSpectrogramArea();
+
+    if (sampleRate <= 0 || area.isEmpty())
+        return;
+
+    // One column per pixel across, one row per point up; paint() stretches the rows to the area's height
+    spectrogramImage = juce::Image(juce::Image::ARGB, area.getWidth(),
+                                   SpectrumAnalyser::numPoints - getSpectrogramFirstPoint(sampleRate), true);
+}
+
+void SpectrumAnalyserComponent::writeSpectrogramColumn(const std::array<float, SpectrumAnalyser::numPoints>& magnitudesDb)
+{
+    const int numRows = spectrogramImage.getHeight();
+    const int lastColour = (int)spectrogramColours.size() - 1;
+    const float dbToColour = (float)lastColour / (maxDb - minDb);
+
+    // Only the new column is locked, so the cost doesn't grow with the history
+    juce::Image::BitmapData column(spectrogramImage, spectrogramWriteX, 0, 1, numRows, juce::Image::BitmapData::writeOnly);
+
+    // For EACH ROW:
+    for (int row = 0; row < numRows; ++row)
+    {
+        const float db = magnitudesDb[(size_t)(SpectrumAnalyser::numPoints - 1 - row)];
+        const int colour = juce::jlimit(0, lastColour, (int)((db - minDb) * dbToColour));
+
+        reinterpret_cast<juce::PixelARGB*>(column.getPixelPointer(0, row))->set(spectrogramColours[(size_t)colour]);
+    }
+
+    spectrogramWriteX = (spectrogramWriteX + 1) % spectrogramImage.getWidth();
+}
+
+void SpectrumAnalyserComponent::setDisplayMode(DisplayMode newMode)
+{
+    displayMode = newMode;
+    backgroundImage = juce::Image();    // Different labels per mode
+    spectrogramImage = juce::Image();   // History restarts from the next frame
+    repaint();
+}
+
 void SpectrumAnalyserComponent::resized()
 {
+    backgroundImage = juce::Image(); // Redrawn at the new size on the next paint
+    spectrogramImage = juce::Image(); // Columns are pixels, so the history restarts at the new width
+    updatePointMapping(audioProcessor.getSampleRate());
+}
+
+void SpectrumAnalyserComponent::updatePointMapping(double sampleRate)
+{
+    mappedSampleRate = sampleRate;
+    columns.clear();
+
+    auto bounds = getLocalBounds().toFloat().reduced(10.0f); // Same area as paint()
+    const float maxFreq = (float)sampleRate / 2.0f;
+
+    if (sampleRate <= 0 || maxFreq <= minFreq)
+        return;
+
+    const float logMinFreq = std::log(minFreq);
+    const float logFreqRange = std::log(maxFreq) - logMinFreq;
+
+    // For EACH POINT:
+    for (int point = 0; point < SpectrumAnalyser::numPoints; ++point)
+    {
+        const float frequency = (float)sampleRate * SpectrumAnalyser::getPointFrequency(point);
+
+        if (frequency < minFreq) continue;  // Skip out of range points
+        if (frequency > maxFreq) break;
+
+        const float normalisedX = (std::log(frequency) - logMinFreq) / logFreqRange; // Map frequency logarithmically to 0.0 - 1.0
+        const float x = bounds.getX() + bounds.getWidth() * normalisedX;
+
+        // A point in the same pixel column as the one before joins its column
+        if (!columns.empty() && (int)std::floor(columns.back().x) == (int)std::floor(x))
+            ++columns.back().numPoints;
+        else
+            columns.push_back({ x, point, 1 });
+    }
+}
+
+juce::Path SpectrumAnalyserComponent::createSpectrumPath(const std::vector<float>& magnitudes) const
+{
+    auto bounds = getLocalBounds().toFloat().reduced(10.0f);
+
+    // Map dB to a y position, clamped to the plot
+    auto dbToY = [&](float db)
+    {
+        const float normalisedY = juce::jmap(db, minDb, maxDb, 0.0f, 1.0f);
+        return bounds.getBottom() - bounds.getHeight() * juce::jlimit(0.0f, 1.0f, normalisedY);
+    };
+
+    juce::Path spectrumPath;
+    spectrumPath.preallocateSpace((int)columns.size() * 6); // Two lineTo()s per column, three floats each
+    bool pathStarted = false;
+
+    // For EACH COLUMN:
+    for (const auto& column : columns)
+    {
+        const float* columnDb = magnitudes.data() + column.firstPoint;
+        const auto [lowest, highest] = std::minmax_element(columnDb, columnDb + column.numPoints);
+        const float y = dbToY(*highest);
+
+        if (!pathStarted)
+        {
+            spectrumPath.startNewSubPath(column.x, y); // Start path at x,y
+            pathStarted = true;
+        }
+        else
+        {
+            spectrumPath.lineTo(column.x, y);
+        }
+
+        if (*lowest != *highest)
+            spectrumPath.lineTo(column.x, dbToY(*lowest)); // The column's full range, as one vertical stroke
+    }
+
+    return spectrumPath;
 }
\ No newline at end of file
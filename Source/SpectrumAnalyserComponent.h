@@ -11,7 +11,8 @@
 //==============================================================================
 class SpectrumAnalyserComponent : 
     public juce::Component,
-    private juce::Timer, // Timer to periodically update
+    private juce::AsyncUpdater, // Re-checks the vblank attachment when the component may have been hidden
+    private juce::Timer,        // Watches for a minimised window coming back, see updateVBlankAttachment()
     public juce::SettableTooltipClient
 {
 public:
@@ -23,6 +24,9 @@ public:
     // juce::Component overrides
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void mouseDown(const juce::MouseEvent& event) override;  // Right-click for analysis settings
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
 
     const float minDb = -96.0f;
     const float maxDb = 6.0f;
@@ -32,14 +36,82 @@ public:
 
 private:
     SimpleGainSliderAudioProcessor& audioProcessor;
+    SpectrumAnalyser& analyser;     // Attached for the component's lifetime, and only running while showing
+    bool analyserShowing = false;   // What this component last told the processor
     
+    // Once per display refresh while showing: picks up a new spectrum and repaints if anything visibly moved
+    void onVBlank();
+    void handleAsyncUpdate() override;
     void timerCallback() override;
 
+    // Attach to the display's vblank and run the analyser while showing, pause both otherwise. Restoring a
+    // minimised window calls back nothing here, so while on screen but not showing a slow timer checks for it
+    void updateVBlankAttachment();
+
+    // Smoothed curves moved far enough since the last repaint to show
+    bool curvesMovedSinceRepaint() const;
+
+    void showSettingsMenu();
+
+    // One pixel column of the curve. Points that land in the same column are drawn as their min and max
+    struct PixelColumn
+    {
+        float x = 0.0f;
+        int firstPoint = 0;
+        int numPoints = 0;
+    };
+
+    // Work out which column each visible point falls in, for the current bounds and sampleRate
+    void updatePointMapping(double sampleRate);
+
+    // Curve through the columns, at most two vertices per column whatever the number of points
+    juce::Path createSpectrumPath(const std::vector<float>& magnitudes) const;
+
+    // Redraw the grid, axes, labels and legend into backgroundImage
+    void renderBackground(float sampleRate, float scale);
+
+    // === Spectrogram ===
+
+    enum class DisplayMode { spectrum, spectrogram };
+
+    void setDisplayMode(DisplayMode newMode);
+
+    // Plot area less a margin on the left for the frequency labels
+    juce::Rectangle<int> getSpectrogramArea() const;
+
+    // Lowest point at or above minFreq, drawn in the bottom row
+    int getSpectrogramFirstPoint(double sampleRate) const;
+
+    // Size spectrogramImage to the area and sample rate, clearing the history
+    void resetSpectrogram(double sampleRate);
+
+    // Colour one frame into the column at spectrogramWriteX, then move the write position on
+    void writeSpectrogramColumn(const std::array<float, SpectrumAnalyser::numPoints>& magnitudesDb);
+
+    // Frequency labels down the spectrogram's left edge
+    void drawSpectrogramLabels(juce::Graphics& g, float sampleRate) const;
+
  
-    std::vector<float> fftDisplayData;
     std::vector<float> fftSmoothedData;
+    std::vector<float> inputSmoothedData;   // Input before the in-gain stage, drawn under the output
+    juce::uint32 lastSequence = 0;     // Sequence of the last spectrum smoothed in
+    std::vector<float> repaintedData;       // fftSmoothedData and inputSmoothedData as of the last repaint
+    std::vector<float> repaintedInputData;
+    std::vector<PixelColumn> columns;   // Left to right, only points from minFreq to Nyquist
+    double mappedSampleRate = 0.0;      // Sample rate columns was built for
     const float smoothingFactor = 0.2f;
-    juce::Image spectrogramImage;
+
+    DisplayMode displayMode = DisplayMode::spectrum;
+    juce::Image spectrogramImage;       // Circular, one column per frame. Null until the first frame after a reset
+    int spectrogramWriteX = 0;          // Column the next frame goes in, so also the oldest one
+    double spectrogramSampleRate = 0.0; // Sample rate the rows were laid out for
+    std::array<juce::PixelARGB, 256> spectrogramColours;  // minDb to maxDb in even steps, built once
+
+    juce::Image backgroundImage;        // Everything but the curves. Null until the first paint after resized()
+    float backgroundSampleRate = 0.0f;  // What backgroundImage was drawn for
+    float backgroundScale = 1.0f;
+
+    juce::VBlankAttachment vBlankAttachment;    // Empty while the component isn't showing, so hidden editors cost nothing
 
  
 
@@ -0,0 +1,59 @@
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Lock-free single-writer/single-reader triple buffer.
+
+    The writer always owns one slot and the reader another, and the third sits
+    in the middle holding the latest published value. publish() and
+    acquireLatest() swap the caller's slot with the middle one in a single
+    atomic exchange, so neither side waits, copies or allocates. Values the
+    reader never picked up are simply overwritten.
+*/
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+
+    // Writer: the slot to fill. Only the writer touches it until publish()
+    T& getWriteBuffer() noexcept { return slots[(size_t)writeIndex]; }
+
+    // Writer: make the write slot the latest value and take the middle slot to write into next
+    void publish() noexcept
+    {
+        writeIndex = middle.exchange(writeIndex | freshFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Reader: swap in the latest published slot. False if nothing new was published since the last call
+    bool acquireLatest() noexcept
+    {
+        if ((middle.load(std::memory_order_relaxed) & freshFlag) == 0)
+            return false;
+
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    // Reader: the slot from the last acquireLatest(). Valid until the next acquireLatest()
+    const T& getReadBuffer() const noexcept { return slots[(size_t)readIndex]; }
+
+    // Set every slot, e.g. to a silent initial value. Not thread safe
+    void fill(const T& value)
+    {
+        for (auto& slot : slots)
+            slot = value;
+    }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshFlag = 4;   // Set in middle when it holds a value the reader hasn't taken
+
+    std::array<T, 3> slots{};
+    int writeIndex = 0;
+    std::atomic<int> middle{ 1 };
+    int readIndex = 2;
+
+    JUCE_DECLARE_NON_COPYABLE(TripleBuffer)
+};
@@ -0,0 +1,32 @@
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+/**
+    Timing helper for the "Benchmarks" tests.
+
+    A measurement runs its body several times and keeps the fastest run, which
+    leaves out scheduler noise and first-touch page faults. Results are
+    divided down to a per-item figure (usually nanoseconds per sample), so
+    different block sizes and settings compare directly.
+*/
+namespace Benchmark
+{
+    // Fastest of numRuns calls to body(), in nanoseconds per item
+    template <typename Body>
+    double nanosecondsPerItem(Body&& body, double numItems, int numRuns = 21)
+    {
+        double bestSeconds = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < numRuns; ++run)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+            body();
+            const auto elapsed = juce::Time::getHighResolutionTicks() - start;
+
+            bestSeconds = juce::jmin(bestSeconds, juce::Time::highResolutionTicksToSeconds(elapsed));
+        }
+
+        return bestSeconds * 1.0e9 / numItems;
+    }
+}
@@ -0,0 +1,77 @@
+#include <JuceHeader.h>
+#include "../../Source/DspKernels.h"
+#include "Benchmark.h"
+
+//==============================================================================
+class DspKernelsBenchmarks : public juce::UnitTest
+{
+public:
+    DspKernelsBenchmarks() : juce::UnitTest("DspKernels", "Benchmarks") {}
+
+    void runTest() override
+    {
+        juce::ScopedNoDenormals noDenormals; // As in processBlock. Repeated in-place multiplies would otherwise decay into denormals
+
+        // 64 is the processor's tile, 1024 an analyser frame's bins
+        for (int numSamples : { 64, 1024 })
+        {
+            beginTest("Kernels per SIMD level, " + juce::String(numSamples) + " values");
+
+            // Noise in (-1, 1) for the gain and delay kernels, power in (0, 1] for the dB ones
+            std::vector<float> input((size_t)(2 * numSamples + 3)), gains((size_t)numSamples), output((size_t)numSamples);
+            juce::Random random(1);
+
+            for (auto& value : input)
+                value = random.nextFloat() * 2.0f - 1.0f;
+
+            for (auto& gain : gains)
+                gain = random.nextFloat();
+
+            const float coefficients[4] = { -0.0625f, 0.5625f, 0.5625f, -0.0625f };
+            constexpr int numCalls = 4096;
+            double genericTimes[4] = {};
+
+            // For EACH LEVEL this CPU runs:
+            for (auto level : { SimdLevel::generic, SimdLevel::sse2, SimdLevel::avx2, SimdLevel::avx512 })
+            {
+                if (level > DspKernels::getHighestSupportedLevel())
+                    break;
+
+                const auto& kernels = DspKernels::forLevel(level);
+
+                const double times[4] =
+                {
+                    time(numCalls, numSamples, [&] { kernels.multiply(output.data(), gains.data(), numSamples); }),
+                    time(numCalls, numSamples, [&] { kernels.cubicFir(output.data(), input.data(), coefficients, numSamples); }),
+                    time(numCalls, numSamples, [&] { kernels.powerToDecibels(output.data(), input.data(), 0.5f, -100.0f, numSamples); }),
+                    time(numCalls, numSamples, [&] { kernels.decibelsFromPower(output.data(), gains.data(), -100.0f, numSamples); })
+                };
+
+                if (level == SimdLevel::generic)
+                    std::copy(std::begin(times), std::end(times), genericTimes);
+
+                juce::String line(DspKernels::getLevelName(level));
+                const char* names[] = { "multiply", "cubicFir", "powerToDecibels", "decibelsFromPower" };
+
+                for (int kernel = 0; kernel < 4; ++kernel)
+                    line << ", " << names[kernel] << " " << juce::String(times[kernel], 3) << " ns ("
+                         << juce::String(genericTimes[kernel] / times[kernel], 1) << "x)";
+
+                logMessage(line + " per value");
+            }
+        }
+    }
+
+private:
+    template <typename Body>
+    static double time(int numCalls, int numSamples, Body&& body)
+    {
+        return Benchmark::nanosecondsPerItem([&]
+        {
+            for (int call = 0; call < numCalls; ++call)
+                body();
+        }, (double)numCalls * numSamples);
+    }
+};
+
+static DspKernelsBenchmarks dspKernelsBenchmarks;
@@ -0,0 +1,160 @@
+#include <JuceHeader.h>
+#include "../../Source/DspKernels.h"
+#include "../../Source/DelayInterpolation.h"
+
+//==============================================================================
+class DspKernelsTests : public juce::UnitTest
+{
+public:
+    DspKernelsTests() : juce::UnitTest("DspKernels", "Tests") {}
+
+    void runTest() override
+    {
+        constexpr float minDb = -100.0f;        // SpectrumAnalyser::minDb, a power of 1e-10
+        constexpr double maxErrorDb = 1.0e-4;   // The bound DspKernels.h promises
+
+        // Powers log-spaced from 1e-14 (well under the clamp) to 1e4, then the edge cases. An odd count
+        // leaves a tail for every vector width
+        std::vector<float> powers;
+
+        for (int i = 0; i < 180001; ++i)
+            powers.push_back((float)std::pow(10.0, -14.0 + 18.0 * i / 180000.0));
+
+        for (float edge : { 0.0f, 1.0e-10f, std::nextafter(1.0e-10f, 0.0f), std::nextafter(1.0e-10f, 1.0f),
+                            std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::min(), 1.0f })
+            powers.push_back(edge);
+
+        const int numValues = (int)powers.size();
+
+        // The same powers as complex bins for powerToDecibels, scaled back up by 1 / scale
+        constexpr float scale = 1.0f / 4096.0f;
+        std::vector<float> bins((size_t)numValues * 2);
+
+        for (int i = 0; i < numValues; ++i)
+        {
+            bins[(size_t)i * 2] = std::sqrt(powers[(size_t)i] / scale * 0.75f);
+            bins[(size_t)i * 2 + 1] = -std::sqrt(powers[(size_t)i] / scale * 0.25f);
+        }
+
+        // Scalar std::log10 in double, from the values each kernel actually sees
+        auto referenceDb = [](double power) { return juce::jmax((double)minDb, 10.0 * std::log10(power)); };
+
+        std::vector<float> fromPower((size_t)numValues), fromBins((size_t)numValues);
+
+        // For EACH LEVEL this CPU runs:
+        for (auto level : { SimdLevel::generic, SimdLevel::sse2, SimdLevel::avx2, SimdLevel::avx512 })
+        {
+            if (level > DspKernels::getHighestSupportedLevel())
+                break;
+
+            beginTest(juce::String("dB error against std::log10, ") + DspKernels::getLevelName(level));
+
+            const auto& kernels = DspKernels::forLevel(level);
+            kernels.decibelsFromPower(fromPower.data(), powers.data(), minDb, numValues);
+            kernels.powerToDecibels(fromBins.data(), bins.data(), scale, minDb, numValues);
+
+            double worstFromPower = 0.0, worstFromBins = 0.0;
+            bool clampedExactly = true;
+
+            for (int i = 0; i < numValues; ++i)
+            {
+                const double power = powers[(size_t)i];
+                const double re = bins[(size_t)i * 2], im = bins[(size_t)i * 2 + 1];
+                const double binPower = (re * re + im * im) * scale;
+
+                worstFromPower = juce::jmax(worstFromPower, std::abs(fromPower[(size_t)i] - referenceDb(power)));
+                worstFromBins = juce::jmax(worstFromBins, std::abs(fromBins[(size_t)i] - referenceDb(binPower)));
+
+                // Below the clamp with room to spare, the floor must come out exactly
+                if (power < 0.9e-10)
+                    clampedExactly = clampedExactly && fromPower[(size_t)i] == minDb;
+
+                if (binPower < 0.9e-10)
+                    clampedExactly = clampedExactly && fromBins[(size_t)i] == minDb;
+            }
+
+            logMessage(juce::String("max error: decibelsFromPower ") + juce::String(worstFromPower, 7)
+                       + " dB, powerToDecibels " + juce::String(worstFromBins, 7) + " dB");
+
+            expectLessThan(worstFromPower, maxErrorDb, "decibelsFromPower");
+            expectLessThan(worstFromBins, maxErrorDb, "powerToDecibels");
+            expect(clampedExactly, "Powers below 1e-10 give exactly minDb");
+        }
+
+        testBitIdenticalToGeneric();
+    }
+
+private:
+    // The vector multiply and cubicFir keep the generic operation order, and DspKernels.cpp is built with
+    // -ffp-contract=off (the noFpContract scheme) so nothing gets fused. Every level must match generic to the bit,
+    // at every tail length and alignment
+    void testBitIdenticalToGeneric()
+    {
+        constexpr int maxSamples = 300;     // Past two AVX-512 cubicFir bodies, with every tail length below it
+        constexpr int maxOffset = 16;       // Pointers at every float offset within a 64-byte line
+
+        juce::Random random(5);
+        std::vector<float> taps((size_t)(maxSamples + 3 + maxOffset)), gains((size_t)(maxSamples + maxOffset));
+        std::vector<float> data((size_t)(maxSamples + maxOffset));
+
+        for (auto& tap : taps)
+            tap = random.nextFloat() * 2.0f - 1.0f;
+
+        for (auto& gain : gains)
+            gain = random.nextFloat() * 2.0f;
+
+        for (auto& sample : data)
+            sample = random.nextFloat() * 2.0f - 1.0f;
+
+        // Cubic weights at a few fractional delays, as processDelayConstant passes them
+        std::vector<std::array<float, 4>> coefficientSets;
+
+        for (float fraction : { 0.0f, 0.25f, 0.5f, 0.7071f, 0.999f })
+        {
+            float coefficients[4];
+            CubicInterpolator::getCoefficients(fraction, coefficients);
+            coefficientSets.push_back({ coefficients[0], coefficients[1], coefficients[2], coefficients[3] });
+        }
+
+        const auto& generic = DspKernels::forLevel(SimdLevel::generic);
+        std::vector<float> expected((size_t)maxSamples), actual((size_t)maxSamples);
+
+        // For EACH VECTOR LEVEL this CPU runs:
+        for (auto level : { SimdLevel::sse2, SimdLevel::avx2, SimdLevel::avx512 })
+        {
+            if (level > DspKernels::getHighestSupportedLevel())
+                break;
+
+            beginTest(juce::String("multiply and cubicFir bit-identical to generic, ") + DspKernels::getLevelName(level));
+
+            const auto& kernels = DspKernels::forLevel(level);
+            bool multiplyMatches = true, cubicFirMatches = true;
+
+            for (int offset = 0; offset < maxOffset; ++offset)
+            {
+                for (int numSamples = 0; numSamples <= maxSamples; ++numSamples)
+                {
+                    const auto bytes = sizeof(float) * (size_t)numSamples;
+
+                    std::copy(data.begin() + offset, data.begin() + offset + numSamples, expected.begin());
+                    std::copy(data.begin() + offset, data.begin() + offset + numSamples, actual.begin());
+                    generic.multiply(expected.data(), gains.data() + offset, numSamples);
+                    kernels.multiply(actual.data(), gains.data() + offset, numSamples);
+                    multiplyMatches = multiplyMatches && std::memcmp(expected.data(), actual.data(), bytes) == 0;
+
+                    for (const auto& coefficients : coefficientSets)
+                    {
+                        generic.cubicFir(expected.data(), taps.data() + offset, coefficients.data(), numSamples);
+                        kernels.cubicFir(actual.data(), taps.data() + offset, coefficients.data(), numSamples);
+                        cubicFirMatches = cubicFirMatches && std::memcmp(expected.data(), actual.data(), bytes) == 0;
+                    }
+                }
+            }
+
+            expect(multiplyMatches, "multiply");
+            expect(cubicFirMatches, "cubicFir");
+        }
+    }
+};
+
+static DspKernelsTests dspKernelsTests;
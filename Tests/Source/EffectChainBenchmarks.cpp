@@ -0,0 +1,157 @@
+#include <JuceHeader.h>
+#include "../../Source/EffectChain.h"
+#include "Benchmark.h"
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int processorTileSize = 64;       // SimpleGainSliderAudioProcessor::processingTileSize
+    constexpr int framesPerRun = 1 << 17;       // About 2.7 s of audio per timed run, whatever the block size
+
+    // Settings for one timed chain
+    struct ChainSetup
+    {
+        int numChannels = 2;
+        int blockSize = 512;
+        int tileSize = processorTileSize;   // Equal to blockSize to run each stage over the whole block
+        bool delayMoving = false;           // New delay target every block, so the ramp never settles
+        float delaySeconds = 0.3f;          // 0.3 s is a whole number of samples at 48 kHz
+        DelayLayout delayLayout = DelayLayout::automatic;
+    };
+
+    // Nanoseconds per sample per channel for the whole chain, with the compressor working
+    template <typename SampleType>
+    double timeChain(const ChainSetup& setup)
+    {
+        EffectChain<SampleType> chain;
+        chain.setKernels(DspKernels::forLevel(DspKernels::getDefaultLevel()));
+        chain.setDelayLayout(setup.delayLayout);
+        chain.prepare(sampleRate, setup.numChannels, setup.tileSize);
+        chain.setCompressorThreshold(-20.0f);
+        chain.setCompressorRatio(4.0f);
+        chain.setCompressorAttack(10.0f);
+        chain.setCompressorRelease(100.0f);
+        chain.setParameters(-3.0f, 0.0f, setup.delaySeconds, 0.5f);
+
+        // Input noise, copied into the block before each pass
+        juce::AudioBuffer<SampleType> noise(setup.numChannels, setup.blockSize);
+        juce::Random random(1);
+
+        for (int channel = 0; channel < setup.numChannels; ++channel)
+            for (int i = 0; i < setup.blockSize; ++i)
+                noise.getWritePointer(channel)[i] = (SampleType)(random.nextFloat() - 0.5f);
+
+        juce::AudioBuffer<SampleType> buffer(setup.numChannels, setup.blockSize);
+        const juce::dsp::AudioBlock<SampleType> block(buffer);
+        const int numBlocks = juce::jmax(1, framesPerRun / setup.blockSize);
+
+        auto processRun = [&]
+        {
+            for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+            {
+                if (setup.delayMoving)
+                    chain.setParameters(-3.0f, 0.0f, setup.delaySeconds + ((blockIndex & 1) != 0 ? 0.0f : 0.01f), 0.5f);
+
+                for (int channel = 0; channel < setup.numChannels; ++channel)
+                    buffer.copyFrom(channel, 0, noise.getReadPointer(channel), setup.blockSize);
+
+                for (int start = 0; start < setup.blockSize; start += setup.tileSize)
+                    chain.processTile(block.getSubBlock((size_t)start, (size_t)juce::jmin(setup.tileSize, setup.blockSize - start)));
+            }
+        };
+
+        processRun(); // Fills the delay line and settles the smoothers
+        return Benchmark::nanosecondsPerItem(processRun, (double)numBlocks * setup.blockSize * setup.numChannels);
+    }
+
+    juce::String describe(bool delayMoving)
+    {
+        return delayMoving ? "moving delay" : "settled delay";
+    }
+}
+
+//==============================================================================
+class EffectChainBenchmarks : public juce::UnitTest
+{
+public:
+    EffectChainBenchmarks() : juce::UnitTest("EffectChain", "Benchmarks") {}
+
+    void runTest() override
+    {
+        beginTest("Fused tiles against whole-block stages, stereo float");
+
+        // Whole block: the chain is prepared for the block size and each stage runs over all of it in turn
+        for (int blockSize : { 2048, 4096, 8192 })
+        {
+            for (bool delayMoving : { false, true })
+            {
+                const double wholeBlock = timeChain<float>({ 2, blockSize, blockSize, delayMoving });
+                const double tiled = timeChain<float>({ 2, blockSize, processorTileSize, delayMoving });
+
+                logMessage("block " + juce::String(blockSize) + ", " + describe(delayMoving)
+                           + ": whole block " + juce::String(wholeBlock, 2) + " ns, "
+                           + juce::String(processorTileSize) + "-frame tiles " + juce::String(tiled, 2)
+                           + " ns per sample, " + juce::String(wholeBlock / tiled, 2) + "x");
+            }
+        }
+
+        beginTest("Double against float, stereo, 512-frame blocks");
+
+        for (bool delayMoving : { false, true })
+        {
+            ChainSetup setup;
+            setup.delayMoving = delayMoving;
+
+            const double single = timeChain<float>(setup);
+            const double twice = timeChain<double>(setup);
+
+            logMessage(describe(delayMoving) + ": float " + juce::String(single, 2) + " ns, double "
+                       + juce::String(twice, 2) + " ns per sample, double costs " + juce::String(twice / single, 2) + "x");
+        }
+
+        beginTest("Scaling with channel count, float");
+
+        // Linear scaling shows up as a flat cost per channel. 6 is 5.1, 12 is 7.1.4, 16 is third-order ambisonics
+        const double mono = timeChain<float>({ 1 });
+
+        for (int numChannels : { 1, 2, 4, 6, 8, 12, 16 })
+        {
+            const double perChannel = timeChain<float>({ numChannels });
+
+            logMessage(juce::String(numChannels) + " channels: " + juce::String(perChannel, 2) + " ns per sample per channel, "
+                       + juce::String(perChannel / mono, 2) + "x mono");
+        }
+
+        beginTest("Interleaved against planar delay line, stereo");
+
+        // Integer, fractional and moving delays take different kernels in each layout
+        struct DelayCase { const char* name; float seconds; bool moving; };
+
+        for (const auto& delayCase : { DelayCase{ "integer delay", 0.3f, false },
+                                       DelayCase{ "fractional delay", 0.30001f, false },
+                                       DelayCase{ "moving delay", 0.3f, true } })
+        {
+            const auto timeLayouts = [&](auto sampleType, const char* typeName)
+            {
+                using SampleType = decltype(sampleType);
+                ChainSetup setup;
+                setup.delayMoving = delayCase.moving;
+                setup.delaySeconds = delayCase.seconds;
+
+                setup.delayLayout = DelayLayout::planar;
+                const double planar = timeChain<SampleType>(setup);
+                setup.delayLayout = DelayLayout::interleaved;
+                const double interleaved = timeChain<SampleType>(setup);
+
+                logMessage(juce::String(typeName) + ", " + delayCase.name + ": planar " + juce::String(planar, 2)
+                           + " ns, interleaved " + juce::String(interleaved, 2) + " ns per sample, interleaved is "
+                           + juce::String(planar / interleaved, 2) + "x");
+            };
+
+            timeLayouts(0.0f, "float");
+            timeLayouts(0.0, "double");
+        }
+    }
+};
+
+static EffectChainBenchmarks effectChainBenchmarks;
@@ -0,0 +1,375 @@
+#include <JuceHeader.h>
+#include "../../Source/EffectChain.h"
+
+namespace
+{
+    constexpr double sampleRate = 1024.0;   // Quarter-sample delays are exact in seconds, and the ring is only 4096 long
+    constexpr int tileSize = 64;            // SimpleGainSliderAudioProcessor::processingTileSize
+
+    struct Parameters
+    {
+        float inGainDb = -3.0f;
+        float outGainDb = 2.0f;
+        float delaySeconds = 0.0f;
+        float feedback = 0.5f;
+    };
+
+    //==============================================================================
+    // The chain one sample at a time, with juce::SmoothedValue ramps and the per-sample cubic delay read.
+    // Each stage runs over the whole block before the next, as processBlock did before tiles
+    template <typename SampleType>
+    class ReferenceChain
+    {
+    public:
+        // Snaps every ramp to the current targets, like EffectChain::prepare()
+        void prepare(int numChannels, int maximumBlockSize)
+        {
+            const int capacity = juce::nextPowerOfTwo((int)(sampleRate * 2.5)); // EffectChain's ring size
+            ring.setSize(numChannels, capacity);
+            ring.clear();
+            mask = capacity - 1;
+            writePosition = 0;
+
+            inGain.reset(sampleRate, 0.05);
+            inGain.setCurrentAndTargetValue(inGainTarget);
+            outGain.reset(sampleRate, 0.05);
+            outGain.setCurrentAndTargetValue(outGainTarget);
+
+            delayTimes.resize((size_t)numChannels);
+            feedbacks.resize((size_t)numChannels);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                delayTimes[(size_t)channel].reset(sampleRate, 0.2);
+                delayTimes[(size_t)channel].setCurrentAndTargetValue(delayTarget);
+                feedbacks[(size_t)channel].reset(sampleRate, 0.05);
+                feedbacks[(size_t)channel].setCurrentAndTargetValue(feedbackTarget);
+            }
+
+            juce::dsp::ProcessSpec spec;
+            spec.maximumBlockSize = (juce::uint32)maximumBlockSize;
+            spec.sampleRate = sampleRate;
+            spec.numChannels = (juce::uint32)numChannels;
+            compressor.prepare(spec);
+            compressor.reset();
+            compressor.setThreshold((SampleType)-20.0);
+            compressor.setRatio((SampleType)4.0);
+            compressor.setAttack((SampleType)10.0);
+            compressor.setRelease((SampleType)100.0);
+        }
+
+        void setParameters(const Parameters& parameters)
+        {
+            inGainTarget = juce::Decibels::decibelsToGain((SampleType)parameters.inGainDb);
+            outGainTarget = juce::Decibels::decibelsToGain((SampleType)parameters.outGainDb);
+            delayTarget = (SampleType)parameters.delaySeconds;
+            feedbackTarget = (SampleType)parameters.feedback;
+
+            inGain.setTargetValue(inGainTarget);
+            outGain.setTargetValue(outGainTarget);
+
+            for (auto& smoother : delayTimes)
+                smoother.setTargetValue(delayTarget);
+
+            for (auto& smoother : feedbacks)
+                smoother.setTargetValue(feedbackTarget);
+        }
+
+        void process(juce::AudioBuffer<SampleType>& buffer)
+        {
+            const int numChannels = buffer.getNumChannels();
+            const int numSamples = buffer.getNumSamples();
+
+            applyGain(buffer, inGain);
+
+            // For EACH CHANNEL, EACH SAMPLE: read 4 taps, interpolate, write dry + feedback
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto* data = buffer.getWritePointer(channel);
+                auto* delayData = ring.getWritePointer(channel);
+
+                for (int sample = 0; sample < numSamples; ++sample)
+                {
+                    const SampleType delayTime = delayTimes[(size_t)channel].getNextValue();
+                    const SampleType feedback = feedbacks[(size_t)channel].getNextValue();
+                    SampleType& writeSample = delayData[(writePosition + sample) & mask];
+
+                    if (delayTime <= 0)
+                    {
+                        writeSample = data[sample];
+                        continue;
+                    }
+
+                    const double readPos = (writePosition + sample) - (delayTime * sampleRate);
+                    const int readPosInt = static_cast<int>(std::floor(readPos));
+
+                    const SampleType delayed = CubicInterpolator::interpolate(delayData[(readPosInt - 1) & mask],
+                                                                              delayData[readPosInt & mask],
+                                                                              delayData[(readPosInt + 1) & mask],
+                                                                              delayData[(readPosInt + 2) & mask],
+                                                                              (SampleType)(readPos - readPosInt));
+                    writeSample = data[sample] + delayed * feedback;
+                    data[sample] += delayed;
+                }
+            }
+            writePosition = (writePosition + numSamples) & mask;
+
+            juce::dsp::AudioBlock<SampleType> block(buffer);
+            compressor.process(juce::dsp::ProcessContextReplacing<SampleType>(block));
+
+            applyGain(buffer, outGain);
+        }
+
+    private:
+        using GainSmoother = juce::SmoothedValue<SampleType, juce::ValueSmoothingTypes::Multiplicative>;
+
+        // One ramp shared by every channel, like GainStage
+        static void applyGain(juce::AudioBuffer<SampleType>& buffer, GainSmoother& smoother)
+        {
+            for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+            {
+                const SampleType gain = smoother.getNextValue();
+
+                for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+                    buffer.getWritePointer(channel)[sample] *= gain;
+            }
+        }
+
+        SampleType inGainTarget = 1, outGainTarget = 1, delayTarget = 0, feedbackTarget = 0;
+        GainSmoother inGain, outGain;
+        std::vector<juce::SmoothedValue<SampleType>> delayTimes, feedbacks;
+        juce::dsp::Compressor<SampleType> compressor;
+
+        juce::AudioBuffer<SampleType> ring;
+        int mask = 0;
+        int writePosition = 0;
+    };
+
+    //==============================================================================
+    // Largest difference between EffectChain, run in tiles, and ReferenceChain, run a whole host block at a
+    // time, on the same stereo noise. parametersForBlock(n) gives the targets set before block n; block 0's are
+    // set before prepare(), so they start settled
+    template <typename SampleType, typename ParametersForBlock>
+    double maxDifferenceFromReference(DelayLayout layout, int numBlocks, int blockSize, ParametersForBlock&& parametersForBlock)
+    {
+        constexpr int numChannels = 2;
+
+        EffectChain<SampleType> chain;
+        chain.setKernels(DspKernels::forLevel(DspKernels::getHighestSupportedLevel()));
+        chain.setDelayLayout(layout);
+
+        ReferenceChain<SampleType> reference;
+
+        const Parameters first = parametersForBlock(0);
+        chain.setParameters(first.inGainDb, first.outGainDb, first.delaySeconds, first.feedback);
+        reference.setParameters(first);
+
+        chain.prepare(sampleRate, numChannels, tileSize);
+        chain.setCompressorThreshold(-20.0f);
+        chain.setCompressorRatio(4.0f);
+        chain.setCompressorAttack(10.0f);
+        chain.setCompressorRelease(100.0f);
+        reference.prepare(numChannels, blockSize);
+
+        juce::AudioBuffer<SampleType> tiled(numChannels, blockSize), whole(numChannels, blockSize);
+        const juce::dsp::AudioBlock<SampleType> block(tiled);
+        juce::Random random(7);
+        double maxDifference = 0.0;
+
+        for (int blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+        {
+            const Parameters parameters = parametersForBlock(blockIndex);
+            chain.setParameters(parameters.inGainDb, parameters.outGainDb, parameters.delaySeconds, parameters.feedback);
+            reference.setParameters(parameters);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    tiled.getWritePointer(channel)[i] = whole.getWritePointer(channel)[i] = (SampleType)(random.nextFloat() - 0.5f);
+
+            for (int start = 0; start < blockSize; start += tileSize)
+                chain.processTile(block.getSubBlock((size_t)start, (size_t)juce::jmin(tileSize, blockSize - start)));
+
+            reference.process(whole);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < blockSize; ++i)
+                    maxDifference = juce::jmax(maxDifference, std::abs((double)tiled.getReadPointer(channel)[i]
+                                                                       - (double)whole.getReadPointer(channel)[i]));
+        }
+
+        return maxDifference;
+    }
+
+    juce::String describe(DelayLayout layout)
+    {
+        return layout == DelayLayout::planar ? "planar" : "interleaved";
+    }
+}
+
+//==============================================================================
+class EffectChainTests : public juce::UnitTest
+{
+public:
+    EffectChainTests() : juce::UnitTest("EffectChain", "Tests") {}
+
+    void runTest() override
+    {
+        testDelayLineSpans();
+        testSettledDelays<float>("float", 1.0e-6);
+        testSettledDelays<double>("double", 1.0e-12);
+        testRampingParameters<float>("float", 1.0e-6);
+        testRampingParameters<double>("double", 1.0e-12);
+    }
+
+private:
+    // Writes at offsets and reads at every delay, against a plain array indexed modulo the capacity
+    void testDelayLineSpans()
+    {
+        beginTest("DelayLine spans, writes and reads across the wrap");
+
+        constexpr int numChannels = 2;
+        DelayLine<float> delayLine;
+        delayLine.prepare(numChannels, 10);
+        expectEquals(delayLine.getCapacity(), 16);
+
+        const int capacity = delayLine.getCapacity();
+        const int mask = delayLine.getMask();
+        std::vector<std::vector<float>> model((size_t)numChannels, std::vector<float>((size_t)capacity, 0.0f));
+
+        // A span must be the region from start, cut where it passes the end of the ring
+        auto spanIsSplitAt = [capacity](const DelayLine<float>::Span& span, const float* ring, int start, int numSamples)
+        {
+            const int size1 = juce::jmin(numSamples, capacity - start);
+            return span.data1 == ring + start && span.size1 == size1 && span.data2 == ring && span.size2 == numSamples - size1;
+        };
+
+        juce::Random random(3);
+        std::vector<float> source((size_t)capacity), destination((size_t)capacity);
+        int position = 0;   // Unwrapped write position
+        bool spansMatch = true, readsMatch = true, sawWrappedWrite = false, sawWrappedRead = false;
+
+        for (int step = 0; step < 500; ++step)
+        {
+            const int numToWrite = 1 + random.nextInt(capacity);
+            const int offset = random.nextInt(capacity - numToWrite + 1);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (auto& sample : source)
+                    sample = random.nextFloat();
+
+                const auto span = delayLine.getWriteSpan(channel, numToWrite, offset);
+                spansMatch = spansMatch && spanIsSplitAt(span, delayLine.getReadPointer(channel), (position + offset) & mask, numToWrite);
+                sawWrappedWrite = sawWrappedWrite || span.size2 > 0;
+
+                delayLine.write(channel, source.data(), numToWrite, offset);
+
+                for (int i = 0; i < numToWrite; ++i)
+                    model[(size_t)channel][(size_t)((position + offset + i) & mask)] = source[(size_t)i];
+            }
+
+            const int numToAdvance = random.nextInt(capacity + 1);
+            delayLine.advance(numToAdvance);
+            position += numToAdvance;
+
+            // For EACH CHANNEL, DELAY AND LENGTH:
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                for (int delay = 1; delay <= capacity; ++delay)
+                {
+                    for (int numToRead = 1; numToRead <= capacity; ++numToRead)
+                    {
+                        const auto span = delayLine.getReadSpan(channel, delay, numToRead);
+                        spansMatch = spansMatch && spanIsSplitAt(span, delayLine.getReadPointer(channel), (position - delay) & mask, numToRead);
+                        sawWrappedRead = sawWrappedRead || span.size2 > 0;
+
+                        delayLine.read(channel, delay, destination.data(), numToRead);
+
+                        for (int i = 0; i < numToRead; ++i)
+                            readsMatch = readsMatch && destination[(size_t)i] == model[(size_t)channel][(size_t)((position - delay + i) & mask)];
+                    }
+                }
+            }
+        }
+
+        expect(spansMatch, "Spans start at the masked position and split where the ring ends");
+        expect(readsMatch, "read() returns what write() put at each position");
+        expect(sawWrappedWrite && sawWrappedRead, "Some writes and reads crossed the wrap");
+    }
+
+    // Settled delays take processDelayConstant's chunked block FIR (planar) or the fixed-weight frame kernel
+    // (interleaved). Both must match the per-sample cubic read at delays short enough to cap the chunk length,
+    // one tile long, and long enough to span most of the ring
+    template <typename SampleType>
+    void testSettledDelays(const juce::String& typeName, double tolerance)
+    {
+        constexpr int blockSize = 100;  // A full tile and a partial one per block
+        constexpr int numBlocks = 200;  // Nearly five trips round the 4096-sample ring
+
+        //  1, 2, 3            integer, chunk capped at the lag
+        //  1.5                too short for the FIR taps, falls back to the per-sample path
+        //  2.25, 2.5, 3.75    fractional, chunk capped at lag - 2
+        //  64, 63.5, 65.25    a tile long, and either side
+        //  1000, 4000.5       far back, reads cross the wrap
+        for (double delayInSamples : { 1.0, 2.0, 3.0, 1.5, 2.25, 2.5, 3.75, 64.0, 63.5, 65.25, 1000.0, 4000.5 })
+        {
+            for (auto layout : { DelayLayout::planar, DelayLayout::interleaved })
+            {
+                beginTest("Settled delay of " + juce::String(delayInSamples, 2) + " samples against the per-sample reference, "
+                          + typeName + " " + describe(layout));
+
+                Parameters parameters;
+                parameters.delaySeconds = (float)(delayInSamples / sampleRate);
+
+                const double difference = maxDifferenceFromReference<SampleType>(layout, numBlocks, blockSize,
+                                                                                 [&](int) { return parameters; });
+
+                expectLessThan(difference, tolerance);
+            }
+        }
+    }
+
+    // Fused tiles against the old order, where each stage ran over the whole host block, while every
+    // parameter ramps. New targets land every other block, so blocks start both mid-ramp and settled.
+    // Delay targets include zero, so ramps cross into and out of the bypass run inside a tile
+    template <typename SampleType>
+    void testRampingParameters(const juce::String& typeName, double tolerance)
+    {
+        constexpr int numBlocks = 120;
+
+        juce::Random random(11);
+        std::vector<Parameters> schedule((size_t)numBlocks);
+
+        for (size_t blockIndex = 0; blockIndex < schedule.size(); ++blockIndex)
+        {
+            if (blockIndex % 2 != 0)
+            {
+                schedule[blockIndex] = schedule[blockIndex - 1];
+                continue;
+            }
+
+            auto& parameters = schedule[blockIndex];
+            parameters.inGainDb = -12.0f + 18.0f * random.nextFloat();
+            parameters.outGainDb = -12.0f + 18.0f * random.nextFloat();
+            parameters.delaySeconds = random.nextInt(4) == 0 ? 0.0f : 2.5f * random.nextFloat();
+            parameters.feedback = 0.9f * random.nextFloat();
+        }
+
+        // 512 is a whole number of tiles, 333 leaves a partial one
+        for (int blockSize : { 512, 333 })
+        {
+            for (auto layout : { DelayLayout::planar, DelayLayout::interleaved })
+            {
+                beginTest("Tiles against whole-block stages with ramping parameters, " + juce::String(blockSize)
+                          + "-frame blocks, " + typeName + " " + describe(layout));
+
+                const double difference = maxDifferenceFromReference<SampleType>(layout, numBlocks, blockSize,
+                                                                                 [&](int blockIndex) { return schedule[(size_t)blockIndex]; });
+
+                expectLessThan(difference, tolerance);
+            }
+        }
+    }
+};
+
+static EffectChainTests effectChainTests;
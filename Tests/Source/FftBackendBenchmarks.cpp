@@ -0,0 +1,107 @@
+#include <JuceHeader.h>
+#include "../../Source/FftBackend.h"
+#include "../../Source/SpectrumAnalyser.h"
+#include "Benchmark.h"
+
+//==============================================================================
+class FftBackendBenchmarks : public juce::UnitTest
+{
+public:
+    FftBackendBenchmarks() : juce::UnitTest("FftBackend", "Benchmarks") {}
+
+    void runTest() override
+    {
+        // For EACH ORDER the analyser offers, the pairs as the analyser passes them and its output buffers
+        for (int order = SpectrumAnalyser::minFftOrder; order <= SpectrumAnalyser::maxFftOrder; ++order)
+        {
+            const int size = 1 << order;
+            auto& buffers = ordersBuffers.emplace_back();
+            buffers.pairs.resize((size_t)size * 2);
+            buffers.firstBins.resize((size_t)size * 2);
+            buffers.secondBins.resize((size_t)size + 2);
+
+            juce::Random random(1);
+
+            for (auto& sample : buffers.pairs)
+                sample = random.nextFloat() - 0.5f;
+        }
+
+        beginTest("Backends at every analyser order, two real transforms per call");
+
+        for (int order = SpectrumAnalyser::minFftOrder; order <= SpectrumAnalyser::maxFftOrder; ++order)
+        {
+            const double juceTime = timeTwoReal(FftBackend::Type::juce, order);
+            juce::String line("order " + juce::String(order) + " (" + juce::String(1 << order) + " points): "
+                              + FftBackend::getTypeName(FftBackend::Type::juce) + " " + juce::String(juceTime, 2) + " us");
+
+            for (auto type : { FftBackend::Type::table, FftBackend::Type::simd })
+            {
+                const double time = timeTwoReal(type, order);
+                line += juce::String(", ") + FftBackend::getTypeName(type) + " " + juce::String(time, 2) + " us ("
+                        + juce::String(juceTime / time, 2) + "x)";
+            }
+
+            logMessage(line);
+        }
+
+        // Two real spectra cost one complex FFT of the same size, so that is the floor for the pair.
+        // What is left over is the split pass
+        for (auto type : { FftBackend::Type::juce, FftBackend::Type::table, FftBackend::Type::simd })
+        {
+            beginTest(juce::String("Two real transforms against one complex FFT, ") + FftBackend::getTypeName(type) + " backend");
+
+            for (int order = SpectrumAnalyser::minFftOrder; order <= SpectrumAnalyser::maxFftOrder; ++order)
+            {
+                const auto backend = FftBackend::create(type, order);
+                auto& buffers = getBuffers(order);
+
+                const double complexTime = timeCalls(order, [&]
+                {
+                    backend->performComplexForwardTransform(buffers.pairs.data(), buffers.firstBins.data());
+                });
+
+                const double twoRealTime = timeTwoReal(type, order);
+
+                logMessage("order " + juce::String(order) + ": complex " + juce::String(complexTime, 2) + " us, two real "
+                           + juce::String(twoRealTime, 2) + " us (" + juce::String(twoRealTime / complexTime, 2) + "x)");
+            }
+        }
+    }
+
+private:
+    struct Buffers
+    {
+        std::vector<float> pairs, firstBins, secondBins;
+    };
+
+    std::vector<Buffers> ordersBuffers;
+
+    Buffers& getBuffers(int order) { return ordersBuffers[(size_t)(order - SpectrumAnalyser::minFftOrder)]; }
+
+    // Microseconds per performTwoRealForwardTransforms() call
+    double timeTwoReal(FftBackend::Type type, int order)
+    {
+        const auto backend = FftBackend::create(type, order);
+        auto& buffers = getBuffers(order);
+
+        return timeCalls(order, [&]
+        {
+            backend->performTwoRealForwardTransforms(buffers.pairs.data(), buffers.firstBins.data(), buffers.secondBins.data());
+        });
+    }
+
+    // Microseconds per call of body, over roughly 4 million points per timed run whatever the size
+    template <typename Body>
+    static double timeCalls(int order, Body&& body)
+    {
+        const int numCalls = juce::jmax(1, (1 << 22) >> order);
+
+        return Benchmark::nanosecondsPerItem([&]
+        {
+            for (int call = 0; call < numCalls; ++call)
+                body();
+        }, (double)numCalls) / 1000.0;
+    }
+};
+
+static FftBackendBenchmarks fftBackendBenchmarks;
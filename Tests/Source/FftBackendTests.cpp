@@ -0,0 +1,70 @@
+#include <JuceHeader.h>
+#include "../../Source/FftBackend.h"
+#include "../../Source/SpectrumAnalyser.h"
+
+//==============================================================================
+class FftBackendTests : public juce::UnitTest
+{
+public:
+    FftBackendTests() : juce::UnitTest("FftBackend", "Tests") {}
+
+    void runTest() override
+    {
+        for (auto type : { FftBackend::Type::juce, FftBackend::Type::table, FftBackend::Type::simd })
+        {
+            beginTest(juce::String("Two real transforms against juce::dsp::FFT real-only transforms, ")
+                      + FftBackend::getTypeName(type) + " backend");
+
+            for (int order = SpectrumAnalyser::minFftOrder; order <= SpectrumAnalyser::maxFftOrder; ++order)
+                testOrder(type, order);
+        }
+    }
+
+private:
+    // Noise pairs through performTwoRealForwardTransforms, and each signal through its own
+    // performRealOnlyForwardTransform(data, true). Bins 0..size/2 must agree to float rounding
+    void testOrder(FftBackend::Type type, int order)
+    {
+        const int size = 1 << order;
+        juce::Random random(order);
+
+        std::vector<float> pairs((size_t)size * 2);
+
+        for (auto& sample : pairs)
+            sample = random.nextFloat() * 2.0f - 1.0f;
+
+        std::vector<float> firstBins((size_t)size * 2), secondBins((size_t)size + 2);
+        FftBackend::create(type, order)->performTwoRealForwardTransforms(pairs.data(), firstBins.data(), secondBins.data());
+
+        const juce::dsp::FFT reference(order);
+        std::vector<float> firstExpected((size_t)size * 2), secondExpected((size_t)size * 2);
+
+        for (int i = 0; i < size; ++i)
+        {
+            firstExpected[(size_t)i] = pairs[(size_t)i * 2];
+            secondExpected[(size_t)i] = pairs[(size_t)i * 2 + 1];
+        }
+
+        reference.performRealOnlyForwardTransform(firstExpected.data(), true);
+        reference.performRealOnlyForwardTransform(secondExpected.data(), true);
+
+        double maxError = 0.0, peak = 0.0;
+
+        for (int bin = 0; bin <= size / 2; ++bin)
+        {
+            const auto re = (size_t)bin * 2, im = re + 1;
+
+            maxError = juce::jmax(maxError,
+                                  std::hypot((double)firstBins[re] - firstExpected[re], (double)firstBins[im] - firstExpected[im]),
+                                  std::hypot((double)secondBins[re] - secondExpected[re], (double)secondBins[im] - secondExpected[im]));
+            peak = juce::jmax(peak,
+                              std::hypot((double)firstExpected[re], (double)firstExpected[im]),
+                              std::hypot((double)secondExpected[re], (double)secondExpected[im]));
+        }
+
+        // Both sides round at every pass, so the bound grows with the order. 2e-7 per pass is about two float epsilons
+        expectLessThan(maxError, 2.0e-7 * order * peak, "order " + juce::String(order));
+    }
+};
+
+static FftBackendTests fftBackendTests;
@@ -0,0 +1,22 @@
+#include <JuceHeader.h>
+
+// Runs every registered juce::UnitTest, or one category: "Tests" (checked, non-zero exit on failure)
+// or "Benchmarks" (timings, mostly logged; a few expect one path to beat another). Build Release for
+// benchmark numbers
+int main(int argc, char* argv[])
+{
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+
+    if (argc > 1)
+        runner.runTestsInCategory(argv[1]);
+    else
+        runner.runAllTests();
+
+    int numFailures = 0;
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        numFailures += runner.getResult(i)->failures;
+
+    return numFailures > 0 ? 1 : 0;
+}
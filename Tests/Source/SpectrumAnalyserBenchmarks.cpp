@@ -0,0 +1,103 @@
+#include <JuceHeader.h>
+#include "../../Source/SpectrumAnalyser.h"
+#include "Benchmark.h"
+
+namespace
+{
+    constexpr int sampleRate = 48000;
+    constexpr int pollSize = sampleRate / 100;      // What the analysis thread finds each 10 ms poll
+
+    SpectrumAnalyser::Settings makeSettings(int fftOrder, SpectrumAnalyser::Overlap overlap, FftBackend::Type backend, bool multiResolution = false)
+    {
+        return { fftOrder, overlap, backend, multiResolution, SpectrumAnalyser::Smoothing::none, SpectrumAnalyser::Source::left };
+    }
+
+    // Milliseconds of analysis per second of 48 kHz audio, pushed and analysed one poll's worth at a time
+    double timeAnalyser(const SpectrumAnalyser::Settings& settings)
+    {
+        SpectrumAnalyser analyser;
+        analyser.setKernels(DspKernels::forLevel(DspKernels::getDefaultLevel()));
+        analyser.setSettings(settings);
+
+        std::vector<float> input((size_t)pollSize), output((size_t)pollSize);
+        juce::Random random(1);
+
+        for (int i = 0; i < pollSize; ++i)
+        {
+            input[(size_t)i] = random.nextFloat() - 0.5f;
+            output[(size_t)i] = random.nextFloat() - 0.5f;
+        }
+
+        auto analyseOneSecond = [&]
+        {
+            for (int poll = 0; poll < sampleRate / pollSize; ++poll)
+            {
+                analyser.pushSamples(input.data(), output.data(), pollSize);
+                analyser.analysePending();
+            }
+        };
+
+        analyseOneSecond(); // Fills the first frames and the long band
+        return Benchmark::nanosecondsPerItem(analyseOneSecond, 1.0e6, 7);
+    }
+
+    const char* getOverlapName(SpectrumAnalyser::Overlap overlap)
+    {
+        switch (overlap)
+        {
+            case SpectrumAnalyser::Overlap::quarter:       return "25%";
+            case SpectrumAnalyser::Overlap::half:          return "50%";
+            case SpectrumAnalyser::Overlap::threeQuarters: return "75%";
+            case SpectrumAnalyser::Overlap::none:          break;
+        }
+
+        return "none";
+    }
+}
+
+//==============================================================================
+class SpectrumAnalyserBenchmarks : public juce::UnitTest
+{
+public:
+    SpectrumAnalyserBenchmarks() : juce::UnitTest("SpectrumAnalyser", "Benchmarks") {}
+
+    void runTest() override
+    {
+        using Overlap = SpectrumAnalyser::Overlap;
+
+        for (auto backend : { FftBackend::Type::juce, FftBackend::Type::table, FftBackend::Type::simd })
+        {
+            beginTest(juce::String("Cost per second of audio, ") + FftBackend::getTypeName(backend) + " backend");
+
+            // For EACH ORDER: one line across the overlaps
+            for (int order = SpectrumAnalyser::minFftOrder; order <= SpectrumAnalyser::maxFftOrder; ++order)
+            {
+                juce::String line("order " + juce::String(order) + " (" + juce::String(1 << order) + " points):");
+
+                for (auto overlap : { Overlap::none, Overlap::quarter, Overlap::half, Overlap::threeQuarters })
+                    line << " " << getOverlapName(overlap) << " " << juce::String(timeAnalyser(makeSettings(order, overlap, backend)), 3) << " ms,";
+
+                logMessage(line.dropLastCharacters(1) + " per second");
+            }
+        }
+
+        beginTest("Multi-resolution against one non-overlapped 2048-point FFT");
+
+        // The budget for multi-resolution mode is the analyser's old fixed setting
+        for (auto backend : { FftBackend::Type::juce, FftBackend::Type::table, FftBackend::Type::simd })
+        {
+            const double single = timeAnalyser(makeSettings(11, Overlap::none, backend));
+            juce::String line(juce::String(FftBackend::getTypeName(backend)) + ": 2048 none " + juce::String(single, 3) + " ms, multi-resolution");
+
+            for (auto overlap : { Overlap::none, Overlap::quarter, Overlap::half, Overlap::threeQuarters })
+            {
+                const double multi = timeAnalyser(makeSettings(SpectrumAnalyser::defaultFftOrder, overlap, backend, true));
+                line << " " << getOverlapName(overlap) << " " << juce::String(multi, 3) << " ms (" << juce::String(multi / single, 2) << "x),";
+            }
+
+            logMessage(line.dropLastCharacters(1) + " per second");
+        }
+    }
+};
+
+static SpectrumAnalyserBenchmarks spectrumAnalyserBenchmarks;
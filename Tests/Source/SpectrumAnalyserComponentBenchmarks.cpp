@@ -0,0 +1,72 @@
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/SpectrumAnalyserComponent.h"
+#include "Benchmark.h"
+
+namespace
+{
+    constexpr int analyserWidth = 650;      // The analyser's bounds in the 800 x 400 editor
+    constexpr int analyserHeight = 167;
+    constexpr int framesPerRun = 100;
+}
+
+//==============================================================================
+class SpectrumAnalyserComponentBenchmarks : public juce::UnitTest
+{
+public:
+    SpectrumAnalyserComponentBenchmarks() : juce::UnitTest("SpectrumAnalyserComponent", "Benchmarks") {}
+
+    void runTest() override
+    {
+        const juce::ScopedJuceInitialiser_GUI gui; // Fonts and images, though nothing goes on screen
+
+        SimpleGainSliderAudioProcessor processor;
+        processor.setRateAndBufferSizeDetails(48000.0, 512); // Without a sample rate paint() stops at the grid
+
+        SpectrumAnalyserComponent component(processor);
+        component.setBounds(0, 0, analyserWidth, analyserHeight);
+
+        // 2 is a HiDPI display, where the background image holds four times the pixels
+        for (int scale : { 1, 2 })
+        {
+            beginTest("Paint time per frame, display scale " + juce::String(scale));
+
+            juce::Image target(juce::Image::RGB, analyserWidth * scale, analyserHeight * scale, true);
+            juce::Graphics g(target);
+            g.addTransform(juce::AffineTransform::scale((float)scale));
+
+            auto paintFrame = [&]
+            {
+                const juce::Graphics::ScopedSaveState state(g);
+                component.paint(g);
+            };
+
+            // resized() drops the background image, so every frame redraws the grid, axes and labels
+            // as paint() did before the image was cached
+            const double redrawn = timeFrames([&] { component.resized(); paintFrame(); });
+            const double cached = timeFrames(paintFrame);
+
+            // The curves sit at the floor with no audio. They cost the same in both
+            logMessage("grid redrawn every frame " + juce::String(redrawn, 1) + " us, cached "
+                       + juce::String(cached, 1) + " us (" + juce::String(redrawn / cached, 1) + "x) per frame");
+
+            // Blitting the image has to beat drawing the grid, axes and text it holds, or the cache isn't worth
+            // its memory
+            expectLessThan(cached, redrawn, "cached frame against redrawn frame");
+        }
+    }
+
+private:
+    // Microseconds per frame
+    template <typename Body>
+    static double timeFrames(Body&& body)
+    {
+        return Benchmark::nanosecondsPerItem([&]
+        {
+            for (int frame = 0; frame < framesPerRun; ++frame)
+                body();
+        }, (double)framesPerRun) / 1000.0;
+    }
+};
+
+static SpectrumAnalyserComponentBenchmarks spectrumAnalyserComponentBenchmarks;